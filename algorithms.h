@@ -0,0 +1,307 @@
+#pragma once
+#include "hardening.h"
+#include "parallel.h"
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Параллельные алгоритмы над SimpleVector и его представлениями.
+// Каждая функция принимает ParallelExecution первым аргументом, а диапазоном может быть
+// SimpleVector, SmallSimpleVector, SimpleVectorView и любой контейнер с begin() и GetSize().
+// Диапазоны короче policy.min_size обрабатываются последовательными аналогами из <algorithm>
+
+namespace algorithms_detail {
+
+// Вызывает task(index) для каждого index из [0, count), по задаче на поток
+template <typename Task>
+void ForEachTask(const ParallelExecution& policy, size_t count, Task task) {
+    ParallelExecution tasks = policy;
+    tasks.min_size = 0;
+    ParallelFor(tasks, count, parallel_detail::ChunkGrid{}, [&task](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; ++index) {
+            task(index);
+        }
+    });
+}
+
+template <typename Range>
+auto MakeView(Range& range) noexcept {
+    return SimpleVectorView(range);
+}
+
+template <typename Type>
+constexpr bool kRadixSortable = std::is_integral_v<Type> && !std::is_same_v<Type, bool>;
+
+template <typename Compare, typename Type>
+constexpr bool kIsAscending = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Type>>;
+
+// Параллельная LSD-сортировка по байтам. На каждом проходе поток строит гистограмму
+// своего куска, префиксные суммы по парам (байт, поток) дают каждому потоку собственные
+// позиции записи, и раскладка идёт без синхронизации. Проходы, на которых у всех ключей
+// один и тот же байт, пропускаются
+template <typename Type>
+void RadixSort(const ParallelExecution& policy, Type* data, size_t size) {
+    using Key = std::make_unsigned_t<Type>;
+    constexpr size_t kBits = std::numeric_limits<Key>::digits;
+    constexpr size_t kDigits = 256;
+    // знаковые ключи сортируются как беззнаковые с инвертированным старшим битом
+    constexpr Key kFlip = std::is_signed_v<Type> ? static_cast<Key>(Key{1} << (kBits - 1)) : Key{0};
+
+    if (size == 0) {
+        return;
+    }
+    const size_t tasks = std::min(parallel_detail::ThreadCount(policy), size);
+    const size_t chunk = (size + tasks - 1) / tasks;
+    SimpleVector<Type> buffer;
+    buffer.ResizeDefaultInit(size);
+    SimpleVector<size_t> offsets(tasks * kDigits);
+    Type* source = data;
+    Type* dest = buffer.Data();
+
+    for (size_t shift = 0; shift < kBits; shift += 8) {
+        const auto digit = [shift](Type value) {
+            return static_cast<size_t>((static_cast<Key>(value) ^ kFlip) >> shift) & (kDigits - 1);
+        };
+        ForEachTask(policy, tasks, [&](size_t task) {
+            size_t* counts = offsets.Data() + task * kDigits;
+            std::fill(counts, counts + kDigits, 0);
+            const size_t end = std::min(size, (task + 1) * chunk);
+            for (size_t i = task * chunk; i < end; ++i) {
+                ++counts[digit(source[i])];
+            }
+        });
+        size_t total = 0;
+        bool single_digit = false;
+        for (size_t d = 0; d < kDigits && !single_digit; ++d) {
+            const size_t digit_start = total;
+            for (size_t task = 0; task < tasks; ++task) {
+                size_t& offset = offsets[task * kDigits + d];
+                total += std::exchange(offset, total);
+            }
+            single_digit = total - digit_start == size;
+        }
+        if (single_digit) {
+            continue;
+        }
+        ForEachTask(policy, tasks, [&](size_t task) {
+            size_t* positions = offsets.Data() + task * kDigits;
+            const size_t end = std::min(size, (task + 1) * chunk);
+            for (size_t i = task * chunk; i < end; ++i) {
+                const Type value = source[i];
+                dest[positions[digit(value)]++] = value;
+            }
+        });
+        std::swap(source, dest);
+    }
+    if (source != data) {
+        ParallelFor(policy, size, parallel_detail::PageGrid(data), [source, data](size_t begin, size_t end) {
+            std::copy(source + begin, source + end, data + begin);
+        });
+    }
+}
+
+// Сколько элементов a входит в первые k элементов устойчивого слияния a и b
+template <typename Type, typename Compare>
+size_t MergePathSplit(const Type* a, size_t a_size, const Type* b, size_t b_size, size_t k, Compare& comp) {
+    size_t low = k > b_size ? k - b_size : 0;
+    size_t high = std::min(k, a_size);
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        if (comp(b[k - mid - 1], a[mid])) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return low;
+}
+
+// Параллельная сортировка слиянием. Сначала каждый поток сортирует свой отрезок std::sort,
+// затем отрезки сливаются попарно в несколько раундов. Чтобы в последних раундах, где пар
+// меньше, чем потоков, никто не простаивал, каждое слияние режется по диагоналям
+// (merge path) на равные части, и потоки сливают части независимо
+template <typename Type, typename Compare>
+void MergeSort(const ParallelExecution& policy, Type* data, size_t size, Compare comp) {
+    if (size == 0) {
+        return;
+    }
+    const size_t threads = std::min(parallel_detail::ThreadCount(policy), size);
+    SimpleVector<size_t> bounds(threads + 1);
+    for (size_t run = 0; run <= threads; ++run) {
+        bounds[run] = run * size / threads;
+    }
+    ForEachTask(policy, threads, [&](size_t run) {
+        std::sort(data + bounds[run], data + bounds[run + 1], comp);
+    });
+
+    SimpleVector<Type> buffer(size);
+    Type* source = data;
+    Type* dest = buffer.Data();
+    size_t runs = threads;
+    while (runs > 1) {
+        const size_t pairs = runs / 2;
+        const size_t parts = (threads + pairs - 1) / pairs;
+        const size_t merge_tasks = pairs * parts;
+        // Точки разреза ищутся до слияния: слияние соседней части перемещает элементы,
+        // которые иначе читал бы двоичный поиск
+        SimpleVector<size_t> splits(pairs * (parts + 1));
+        for (size_t pair = 0; pair < pairs; ++pair) {
+            const Type* a = source + bounds[2 * pair];
+            const Type* b = source + bounds[2 * pair + 1];
+            const size_t a_size = bounds[2 * pair + 1] - bounds[2 * pair];
+            const size_t b_size = bounds[2 * pair + 2] - bounds[2 * pair + 1];
+            for (size_t part = 0; part <= parts; ++part) {
+                splits[pair * (parts + 1) + part] =
+                        MergePathSplit(a, a_size, b, b_size, part * (a_size + b_size) / parts, comp);
+            }
+        }
+        ForEachTask(policy, merge_tasks + runs % 2, [&](size_t task) {
+            if (task == merge_tasks) {
+                // непарный последний отрезок переезжает без слияния
+                std::move(source + bounds[runs - 1], source + size, dest + bounds[runs - 1]);
+                return;
+            }
+            const size_t pair = task / parts;
+            const size_t part = task % parts;
+            Type* a = source + bounds[2 * pair];
+            Type* b = source + bounds[2 * pair + 1];
+            const size_t total = bounds[2 * pair + 2] - bounds[2 * pair];
+            const size_t first = part * total / parts;
+            const size_t last = (part + 1) * total / parts;
+            const size_t a_first = splits[pair * (parts + 1) + part];
+            const size_t a_last = splits[pair * (parts + 1) + part + 1];
+            std::merge(std::make_move_iterator(a + a_first), std::make_move_iterator(a + a_last),
+                       std::make_move_iterator(b + (first - a_first)), std::make_move_iterator(b + (last - a_last)),
+                       dest + bounds[2 * pair] + first, comp);
+        });
+        for (size_t run = 0; run <= runs / 2; ++run) {
+            bounds[run] = bounds[std::min(2 * run, runs)];
+        }
+        runs = pairs + runs % 2;
+        bounds[runs] = size;
+        std::swap(source, dest);
+    }
+    if (source != data) {
+        ParallelFor(policy, size, parallel_detail::PageGrid(data), [source, data](size_t begin, size_t end) {
+            std::move(source + begin, source + end, data + begin);
+        });
+    }
+}
+
+}  // namespace algorithms_detail
+
+// Сортирует диапазон по comp. Целые числа по возрастанию сортируются параллельной
+// поразрядной сортировкой, остальное — параллельной сортировкой слиянием; ей нужен
+// временный буфер из GetSize() элементов, построенных конструктором по умолчанию.
+// Сортировка неустойчивая. Если comp бросает исключение, элементы остаются в диапазоне
+// в неопределённом порядке, а часть из них может быть в состоянии после перемещения
+template <typename Range, typename Compare = std::less<>>
+void Sort(const ParallelExecution& policy, Range&& range, Compare comp = {}) {
+    const auto view = algorithms_detail::MakeView(range);
+    using Type = std::remove_reference_t<decltype(*view.begin())>;
+    static_assert(!std::is_const_v<Type>, "Sort needs a mutable range");
+    const size_t size = view.GetSize();
+    if (size < policy.min_size || parallel_detail::ThreadCount(policy) == 1) {
+        std::sort(view.begin(), view.end(), comp);
+    } else if constexpr (algorithms_detail::kRadixSortable<Type> && algorithms_detail::kIsAscending<Compare, Type>) {
+        algorithms_detail::RadixSort(policy, view.begin(), size);
+    } else {
+        algorithms_detail::MergeSort(policy, view.begin(), size, comp);
+    }
+}
+
+// Записывает op(input[i]) в output[i]. Размеры диапазонов должны совпадать;
+// output может совпадать с input
+template <typename InputRange, typename OutputRange, typename Op>
+void Transform(const ParallelExecution& policy, const InputRange& input, OutputRange&& output, Op op) {
+    const auto in = algorithms_detail::MakeView(input);
+    const auto out = algorithms_detail::MakeView(output);
+    SIMPLE_VECTOR_CHECK(out.GetSize() == in.GetSize(), "Transform output size differs from input size");
+    ParallelFor(policy, in.GetSize(), parallel_detail::PageGrid(out.begin()), [&in, &out, &op](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            out[i] = op(in[i]);
+        }
+    });
+}
+
+// Сворачивает диапазон операцией op, начиная с init, как std::reduce: op должна быть
+// ассоциативной и коммутативной, так как куски сворачиваются независимо и в любом порядке
+template <typename Range, typename Value, typename Op = std::plus<>>
+Value Reduce(const ParallelExecution& policy, const Range& range, Value init, Op op = {}) {
+    const auto view = algorithms_detail::MakeView(range);
+    const size_t size = view.GetSize();
+    const size_t tasks = std::min(parallel_detail::ThreadCount(policy), size);
+    if (size < policy.min_size || tasks <= 1) {
+        for (const auto& item : view) {
+            init = op(std::move(init), item);
+        }
+        return init;
+    }
+    std::vector<std::optional<Value>> partials(tasks);
+    algorithms_detail::ForEachTask(policy, tasks, [&](size_t task) {
+        const size_t begin = task * size / tasks;
+        const size_t end = (task + 1) * size / tasks;
+        Value partial(view[begin]);
+        for (size_t i = begin + 1; i < end; ++i) {
+            partial = op(std::move(partial), view[i]);
+        }
+        partials[task] = std::move(partial);
+    });
+    for (std::optional<Value>& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// Возвращает итератор на первый элемент, для которого pred истинно, либо end()
+template <typename Range, typename Pred>
+auto FindIf(const ParallelExecution& policy, Range&& range, Pred pred) {
+    const auto view = algorithms_detail::MakeView(range);
+    const auto data = view.begin();
+    return data + ParallelFindFirst(policy, view.GetSize(), parallel_detail::PageGrid(data),
+                                    [data, &pred](size_t i) {
+                                        return pred(data[i]);
+                                    });
+}
+
+// Возвращает итератор на первый элемент, равный value, либо end()
+template <typename Range, typename Value>
+auto Find(const ParallelExecution& policy, Range&& range, const Value& value) {
+    return FindIf(policy, range, [&value](const auto& item) {
+        return item == value;
+    });
+}
+
+// Как std::lower_bound, но без ветвлений в цикле: на каждом шаге половина диапазона
+// отбрасывается условным присваиванием (cmov), которое не зависит от предсказателя переходов.
+// Число шагов — ровно ceil(log2(size)) независимо от value. Обе возможные середины
+// следующего шага заранее запрашиваются в кэш
+template <typename Range, typename Value, typename Compare = std::less<>>
+auto LowerBound(Range&& sorted, const Value& value, Compare comp = {}) {
+    const auto view = algorithms_detail::MakeView(sorted);
+    auto base = view.begin();
+    size_t size = view.GetSize();
+    if (size == 0) {
+        return base;
+    }
+    while (size > 1) {
+        const size_t half = size / 2;
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(base + half / 2);
+        __builtin_prefetch(base + half + half / 2);
+#endif
+        base = comp(base[half], value) ? base + half : base;
+        size -= half;
+    }
+    return base + (comp(*base, value) ? 1 : 0);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// Аллокатор, выравнивающий каждый блок по Alignment байт (по умолчанию 64 — строка кэша
+// и ширина регистра AVX-512), чтобы векторные циклы над массивом могли использовать
+// выровненные загрузки и не пересекать строки кэша на первом элементе.
+// Размер блока округляется вверх до кратного Alignment: векторный цикл может прочитать
+// последний регистр целиком, не выходя за выделенную память, хотя элементы хвоста
+// за концом массива не инициализированы.
+// Если UseHugePages, блоки от kHugePageSize байт выравниваются по границе большой страницы
+// и помечаются madvise(MADV_HUGEPAGE): ядро отображает их прозрачными большими страницами,
+// и сканирование многогигабайтного массива промахивается мимо TLB в сотни раз реже
+template <typename Type, size_t Alignment = 64, bool UseHugePages = false>
+class AlignedAllocator {
+    static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+    static_assert(Alignment >= alignof(Type), "alignment must not be weaker than alignof(Type)");
+
+public:
+    using value_type = Type;
+
+    static constexpr size_t kAlignment = Alignment;
+    static constexpr size_t kHugePageSize = size_t{2} << 20;
+
+    // std::allocator_traits не умеет перепривязывать шаблоны с нетиповыми параметрами
+    template <typename Other>
+    struct rebind {
+        using other = AlignedAllocator<Other, Alignment, UseHugePages>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename Other>
+    AlignedAllocator(const AlignedAllocator<Other, Alignment, UseHugePages>&) noexcept {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        const size_t bytes = BlockBytes(size);
+        void* p = ::operator new(bytes, BlockAlignment(bytes));
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (IsHuge(bytes)) {
+            // только совет ядру: без поддержки THP блок остаётся на обычных страницах
+            madvise(p, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<Type*>(p);
+    }
+
+    void deallocate(Type* p, size_t size) noexcept {
+        const size_t bytes = BlockBytes(size);
+        ::operator delete(p, bytes, BlockAlignment(bytes));
+    }
+
+    // Расширяет блок на месте, если new_size элементов помещаются в округлённый хвост блока.
+    // Округлённый размер для old_size и new_size тогда совпадает, и deallocate его найдёт
+    bool expand(Type* /*p*/, size_t old_size, size_t new_size) noexcept {
+        return new_size <= static_cast<size_t>(-1) / sizeof(Type)
+               && new_size * sizeof(Type) <= BlockBytes(old_size);
+    }
+
+private:
+    static constexpr bool IsHuge(size_t bytes) noexcept {
+        return UseHugePages && bytes >= kHugePageSize;
+    }
+
+    static size_t RoundUp(size_t bytes, size_t alignment) {
+        if (bytes > static_cast<size_t>(-1) - (alignment - 1)) {
+            throw std::bad_array_new_length{};
+        }
+        return (bytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Размер блока под size элементов вместе с хвостом; одинаков в allocate и deallocate
+    static size_t BlockBytes(size_t size) {
+        if (size > static_cast<size_t>(-1) / sizeof(Type)) {
+            throw std::bad_array_new_length{};
+        }
+        const size_t bytes = RoundUp(size * sizeof(Type), Alignment);
+        return IsHuge(bytes) ? RoundUp(bytes, kHugePageSize) : bytes;
+    }
+
+    static std::align_val_t BlockAlignment(size_t bytes) noexcept {
+        return std::align_val_t{IsHuge(bytes) && kHugePageSize > Alignment ? kHugePageSize : Alignment};
+    }
+};
+
+// Аллокатор для больших массивов, сканируемых целиком: выравнивание по строке кэша,
+// а от 2 МБ — прозрачные большие страницы
+template <typename Type>
+using HugePageAllocator = AlignedAllocator<Type, 64, true>;
+
+template <typename Type, typename Other, size_t Alignment, bool UseHugePages>
+bool operator==(const AlignedAllocator<Type, Alignment, UseHugePages>&,
+                const AlignedAllocator<Other, Alignment, UseHugePages>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other, size_t Alignment, bool UseHugePages>
+bool operator!=(const AlignedAllocator<Type, Alignment, UseHugePages>&,
+                const AlignedAllocator<Other, Alignment, UseHugePages>&) noexcept {
+    return false;
+}
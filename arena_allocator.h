@@ -0,0 +1,193 @@
+#pragma once
+#include "growth_policy.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// Арена для векторов, которые живут и умирают вместе, например на время обработки запроса.
+// Память выдаётся сдвигом указателя по кускам, размер которых растёт вдвое, и возвращается
+// вся сразу вызовом Reset() или деструктором арены. Освобождение отдельного блока ничего
+// не стоит: арена забирает его обратно, только если он последний, иначе просто забывает.
+// Последний выделенный блок можно расширить на месте, пока в текущем куске есть место,
+// поэтому растущий вектор, который выделял память последним, не переносит элементы.
+// Сама арена не потокобезопасна, не копируется и не перемещается
+class SimpleVectorArena {
+    // Заголовок куска, выделенного из кучи; куски связаны в список от нового к старому
+    struct Chunk {
+        Chunk* prev;
+        size_t size;
+    };
+
+public:
+    static constexpr size_t kDefaultChunkSize = size_t{64} << 10;
+
+    // Арена, берущая память из кучи кусками от chunk_size байт
+    explicit SimpleVectorArena(size_t chunk_size = kDefaultChunkSize) noexcept
+        : next_chunk_size_(std::max(chunk_size, sizeof(Chunk) * 2)) {
+    }
+
+    // Арена, которая сначала заполняет буфер вызывающего, например массив на стеке,
+    // и только потом обращается к куче. Буфер должен пережить арену
+    SimpleVectorArena(void* buffer, size_t size, size_t chunk_size = kDefaultChunkSize) noexcept
+        : buffer_(static_cast<char*>(buffer))
+        , top_(buffer_)
+        , end_(buffer_ + size)
+        , next_chunk_size_(std::max({chunk_size, size, sizeof(Chunk) * 2})) {
+    }
+
+    SimpleVectorArena(const SimpleVectorArena&) = delete;
+    SimpleVectorArena& operator=(const SimpleVectorArena&) = delete;
+
+    ~SimpleVectorArena() {
+        FreeChunks(chunks_);
+    }
+
+    // Выделяет bytes байт, выровненных по alignment (степень двойки)
+    [[nodiscard]] void* Allocate(size_t bytes, size_t alignment) {
+        if (char* p = TryBump(bytes, alignment)) {
+            return p;
+        }
+        AddChunk(bytes, alignment);
+        return TryBump(bytes, alignment);
+    }
+
+    // Возвращает блок арене, если он выделен последним; иначе память остаётся занятой до Reset()
+    void Deallocate(void* p, size_t bytes) noexcept {
+        if (static_cast<char*>(p) + bytes == top_) {
+            top_ = static_cast<char*>(p);
+        }
+    }
+
+    // Расширяет блок p с old_bytes до new_bytes, не меняя его адрес.
+    // Удаётся, только если блок выделен последним и текущий кусок вмещает new_bytes
+    bool Expand(void* p, size_t old_bytes, size_t new_bytes) noexcept {
+        char* block = static_cast<char*>(p);
+        if (block + old_bytes != top_ || new_bytes > static_cast<size_t>(end_ - block)) {
+            return false;
+        }
+        top_ = block + new_bytes;
+        return true;
+    }
+
+    // Освобождает всю выданную память разом. Для следующих запросов оставляет последний,
+    // самый большой кусок, поэтому устоявшаяся нагрузка перестаёт обращаться к куче.
+    // Векторы, получившие память из арены, к этому моменту должны быть уничтожены
+    void Reset() noexcept {
+        if (chunks_ == nullptr) {
+            top_ = buffer_;
+            return;
+        }
+        FreeChunks(std::exchange(chunks_->prev, nullptr));
+        top_ = reinterpret_cast<char*>(chunks_ + 1);
+        end_ = reinterpret_cast<char*>(chunks_) + chunks_->size;
+    }
+
+private:
+    char* TryBump(size_t bytes, size_t alignment) noexcept {
+        if (top_ == nullptr) {
+            return nullptr;
+        }
+        const uintptr_t top = reinterpret_cast<uintptr_t>(top_);
+        const size_t padding = (alignment - top % alignment) % alignment;
+        const size_t available = static_cast<size_t>(end_ - top_);
+        if (padding > available || bytes > available - padding) {
+            return nullptr;
+        }
+        char* p = top_ + padding;
+        top_ = p + bytes;
+        return p;
+    }
+
+    // Заводит кусок, в котором точно поместится bytes байт с выравниванием alignment
+    void AddChunk(size_t bytes, size_t alignment) {
+        const size_t overhead = sizeof(Chunk) + alignment;
+        if (bytes > static_cast<size_t>(-1) - overhead) {
+            throw std::bad_array_new_length{};
+        }
+        const size_t size = std::max(next_chunk_size_, bytes + overhead);
+        auto* chunk = static_cast<Chunk*>(::operator new(size));
+        chunk->prev = chunks_;
+        chunk->size = size;
+        chunks_ = chunk;
+        top_ = reinterpret_cast<char*>(chunk + 1);
+        end_ = reinterpret_cast<char*>(chunk) + size;
+        next_chunk_size_ = size <= static_cast<size_t>(-1) / 2 ? size * 2 : size;
+    }
+
+    static void FreeChunks(Chunk* chunk) noexcept {
+        while (chunk != nullptr) {
+            Chunk* prev = chunk->prev;
+            ::operator delete(chunk, chunk->size);
+            chunk = prev;
+        }
+    }
+
+    char* buffer_ = nullptr;
+    Chunk* chunks_ = nullptr;
+    char* top_ = nullptr;
+    char* end_ = nullptr;
+    size_t next_chunk_size_;
+};
+
+// Аллокатор, выдающий память из SimpleVectorArena. Как и std::pmr::polymorphic_allocator,
+// не распространяется при присваивании: копия вектора выделяет память в той же арене
+template <typename Type>
+class ArenaAllocator {
+public:
+    using value_type = Type;
+
+    ArenaAllocator(SimpleVectorArena* arena) noexcept
+        : arena_(arena) {
+    }
+
+    template <typename Other>
+    ArenaAllocator(const ArenaAllocator<Other>& other) noexcept
+        : arena_(other.GetArena()) {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        return static_cast<Type*>(arena_->Allocate(BytesFor(size), alignof(Type)));
+    }
+
+    void deallocate(Type* p, size_t size) noexcept {
+        arena_->Deallocate(p, size * sizeof(Type));
+    }
+
+    bool expand(Type* p, size_t old_size, size_t new_size) noexcept {
+        return new_size <= static_cast<size_t>(-1) / sizeof(Type)
+               && arena_->Expand(p, old_size * sizeof(Type), new_size * sizeof(Type));
+    }
+
+    SimpleVectorArena* GetArena() const noexcept {
+        return arena_;
+    }
+
+private:
+    static size_t BytesFor(size_t size) {
+        if (size > static_cast<size_t>(-1) / sizeof(Type)) {
+            throw std::bad_array_new_length{};
+        }
+        return size * sizeof(Type);
+    }
+
+    SimpleVectorArena* arena_;
+};
+
+template <typename Type, typename Other>
+bool operator==(const ArenaAllocator<Type>& lhs, const ArenaAllocator<Other>& rhs) noexcept {
+    return lhs.GetArena() == rhs.GetArena();
+}
+
+template <typename Type, typename Other>
+bool operator!=(const ArenaAllocator<Type>& lhs, const ArenaAllocator<Other>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Вектор в арене: перед переносом в новый буфер пробует расширить текущий на месте.
+// Уничтожение вектора тривиально разрушаемых элементов сводится к сравнению указателей
+template <typename Type, typename Growth = DoublingGrowth>
+using ArenaSimpleVector = SimpleVector<Type, ArenaAllocator<Type>, InPlaceFirstGrowth<Growth>>;
@@ -1,80 +1,200 @@
 #pragma once
+#include "constexpr_support.h"
+#include "simple_vector_stats.h"
 
 #include <cassert>
 #include <cstdlib>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
-template <typename Type>
+// Признак того, что аллокатор умеет менять размер блока с побайтовым сохранением содержимого:
+// Type* reallocate(Type* p, size_t old_size, size_t new_size)
+template <typename Alloc, typename = void>
+struct HasReallocate : std::false_type {};
+
+template <typename Alloc>
+struct HasReallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+        std::declval<typename std::allocator_traits<Alloc>::value_type*>(), size_t{}, size_t{}))>>
+        : std::true_type {};
+
+// Признак того, что аллокатор умеет расширять блок без переноса:
+// bool expand(Type* p, size_t old_size, size_t new_size)
+template <typename Alloc, typename = void>
+struct HasExpand : std::false_type {};
+
+template <typename Alloc>
+struct HasExpand<Alloc, std::void_t<decltype(std::declval<Alloc&>().expand(
+        std::declval<typename std::allocator_traits<Alloc>::value_type*>(), size_t{}, size_t{}))>>
+        : std::true_type {};
+
+// Владеет неинициализированным буфером из size элементов типа Type,
+// выделенным через аллокатор Alloc (по умолчанию std::allocator<Type>)
+template <typename Type, typename Alloc = std::allocator<Type>>
 class ArrayPtr {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, Type>,
+                  "Alloc::value_type must be Type");
+
 public:
+    using AllocatorType = Alloc;
+
     // Инициализирует ArrayPtr пустым указателем
-    ArrayPtr() = default;
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr() = default;
 
-    // Создаёт в куче массив из size элементов типа Type.
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(const Alloc& alloc) noexcept
+            : alloc_(alloc) {
+    }
+
+    // Выделяет через аллокатор неинициализированную память под size элементов типа Type.
+    // Элементы не конструируются: за их создание и уничтожение отвечает владелец ArrayPtr.
     // Если size == 0, поле raw_ptr_ должно быть равно nullptr
-    explicit ArrayPtr(size_t size)
-            : raw_ptr_(size != 0 ? new Type[size] : nullptr) {
+    SIMPLE_VECTOR_CONSTEXPR explicit ArrayPtr(size_t size, const Alloc& alloc = Alloc())
+            : alloc_(alloc)
+            , raw_ptr_(size != 0 ? Allocate(size) : nullptr)
+            , size_(size) {
     }
 
-    // Конструктор из сырого указателя, хранящего адрес массива в куче либо nullptr
-    explicit ArrayPtr(Type* raw_ptr) noexcept
-            : raw_ptr_(raw_ptr) {
+    // Конструктор из сырого указателя на память под size элементов,
+    // выделенную аллокатором, равным alloc, либо nullptr
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(Type* raw_ptr, size_t size, const Alloc& alloc = Alloc()) noexcept
+            : alloc_(alloc)
+            , raw_ptr_(raw_ptr)
+            , size_(raw_ptr != nullptr ? size : 0) {
     }
 
     // Запрещаем копирование
     ArrayPtr(const ArrayPtr&) = delete;
     
-    ArrayPtr(ArrayPtr&& other) {
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr(ArrayPtr&& other) noexcept
+            : alloc_(std::move(other.alloc_)) {
         raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+        size_ = std::exchange(other.size_, 0);
     }
 
-    ~ArrayPtr() {
-        delete[] raw_ptr_;
+    // Освобождает память, не вызывая деструкторы элементов
+    SIMPLE_VECTOR_CONSTEXPR ~ArrayPtr() {
+        Deallocate();
     }
 
     // Запрещаем присваивание
     ArrayPtr& operator=(const ArrayPtr&) = delete;
     
-    ArrayPtr& operator=(ArrayPtr&& other) {
-        raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+    // Память other должна быть совместима с аллокатором this
+    // либо аллокатор должен распространяться при перемещении
+    SIMPLE_VECTOR_CONSTEXPR ArrayPtr& operator=(ArrayPtr&& other) noexcept {
+        if (this != &other) {
+            Deallocate();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
+            } else {
+                assert(alloc_ == other.alloc_);
+            }
+            raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
         return *this;
     }
 
     // Прекращает владением массивом в памяти, возвращает значение адреса массива
     // После вызова метода указатель на массив должен стать обнулиться
     [[nodiscard]] Type* Release() noexcept {
-        Type* p = raw_ptr_;
-        raw_ptr_ = nullptr;
-        return p;
+        size_ = 0;
+        return std::exchange(raw_ptr_, nullptr);
     }
 
     // Возвращает ссылку на элемент массива с индексом index
-    Type& operator[](size_t index) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
     // Возвращает константную ссылку на элемент массива с индексом index
-    const Type& operator[](size_t index) const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
         assert(raw_ptr_);
         return raw_ptr_[index];
     }
 
     // Возвращает true, если указатель ненулевой, и false в противном случае
-    explicit operator bool() const {
+    SIMPLE_VECTOR_CONSTEXPR explicit operator bool() const {
         return raw_ptr_ != nullptr;
     }
 
     // Возвращает значение сырого указателя, хранящего адрес начала массива
-    Type* Get() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Get() const noexcept {
         return raw_ptr_;
     }
 
-    // Обменивается значениям указателя на массив с объектом other
-    void swap(ArrayPtr& other) noexcept {
+    // Возвращает количество элементов, под которое выделена память
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Alloc& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Меняет размер буфера на new_size элементов через Alloc::reallocate.
+    // Содержимое переносится побайтово, поэтому подходит только для тривиально перемещаемых элементов
+    template <typename A = Alloc, std::enable_if_t<HasReallocate<A>::value, int> = 0>
+    void Reallocate(size_t new_size) {
+        if (new_size == 0) {
+            Deallocate();
+            raw_ptr_ = nullptr;
+        } else if (raw_ptr_ == nullptr) {
+            raw_ptr_ = Allocate(new_size);
+        } else {
+            raw_ptr_ = alloc_.reallocate(raw_ptr_, size_, new_size);
+            simple_vector_stats::RecordAllocation<Type>(new_size);
+        }
+        size_ = new_size;
+    }
+
+    // Пытается расширить буфер до new_size элементов, не меняя его адрес.
+    // Возвращает false, если буфер пуст, аллокатор не умеет expand или расширить блок не удалось
+    SIMPLE_VECTOR_CONSTEXPR bool TryExpand(size_t new_size) {
+        if constexpr (HasExpand<Alloc>::value) {
+            if (raw_ptr_ != nullptr && alloc_.expand(raw_ptr_, size_, new_size)) {
+                simple_vector_stats::RecordAllocation<Type>(new_size);
+                size_ = new_size;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Обменивается значениям указателя на массив с объектом other.
+    // Аллокаторы обмениваются, если этого требует propagate_on_container_swap,
+    // иначе они должны быть равны
+    SIMPLE_VECTOR_CONSTEXPR void swap(ArrayPtr& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
         std::swap(raw_ptr_, other.raw_ptr_);
+        std::swap(size_, other.size_);
     }
 
 private:
+    SIMPLE_VECTOR_CONSTEXPR Type* Allocate(size_t size) {
+        Type* p = AllocTraits::allocate(alloc_, size);
+        simple_vector_stats::RecordAllocation<Type>(size);
+        return p;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Deallocate() noexcept {
+        if (raw_ptr_ != nullptr) {
+            AllocTraits::deallocate(alloc_, raw_ptr_, size_);
+        }
+    }
+
+    Alloc alloc_;
     Type* raw_ptr_ = nullptr;
-};
\ No newline at end of file
+    size_t size_ = 0;
+};
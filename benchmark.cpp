@@ -0,0 +1,359 @@
+// Сравнение SimpleVector и std::vector на одинаковых нагрузках (Google Benchmark).
+// Кроме времени каждое измерение сообщает число выделений памяти и выделенные байты
+// на итерацию: они считаются через глобальные operator new/delete этой программы
+
+#include "simple_vector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// GCC принимает free в заменённом operator delete за несоответствие паре new/delete
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+namespace {
+
+std::atomic<size_t> allocation_count{0};
+std::atomic<size_t> allocated_bytes{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size != 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+// 64-байтная тривиально копируемая структура
+struct Pod64 {
+    long long fields[8];
+};
+
+bool operator==(const Pod64& lhs, const Pod64& rhs) {
+    return std::equal(std::begin(lhs.fields), std::end(lhs.fields), std::begin(rhs.fields));
+}
+
+bool operator<(const Pod64& lhs, const Pod64& rhs) {
+    return std::lexicographical_compare(std::begin(lhs.fields), std::end(lhs.fields),
+                                        std::begin(rhs.fields), std::end(rhs.fields));
+}
+
+// Некопируемый тип, как X в main.cpp
+class X {
+public:
+    X()
+        : X(5) {
+    }
+    X(size_t num)
+        : x_(num) {
+    }
+    X(const X& other) = delete;
+    X& operator=(const X& other) = delete;
+    X(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+    }
+    X& operator=(X&& other) {
+        x_ = std::exchange(other.x_, 0);
+        return *this;
+    }
+    size_t GetX() const {
+        return x_;
+    }
+
+private:
+    size_t x_;
+};
+
+template <typename Type>
+Type MakeValue(size_t i) {
+    if constexpr (std::is_same_v<Type, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (std::is_same_v<Type, Pod64>) {
+        Pod64 pod{};
+        std::iota(std::begin(pod.fields), std::end(pod.fields), static_cast<long long>(i));
+        return pod;
+    } else if constexpr (std::is_same_v<Type, std::string>) {
+        // длиннее буфера SSO, чтобы каждая строка владела памятью
+        return std::string(24, 'a') + std::to_string(i);
+    } else {
+        return Type(i);
+    }
+}
+
+// Единый интерфейс к SimpleVector и std::vector
+
+template <typename Type>
+void PushBack(SimpleVector<Type>& v, Type&& value) {
+    v.PushBack(std::move(value));
+}
+
+template <typename Type>
+void PushBack(std::vector<Type>& v, Type&& value) {
+    v.push_back(std::move(value));
+}
+
+template <typename Type>
+void Reserve(SimpleVector<Type>& v, size_t capacity) {
+    v.Reserve(capacity);
+}
+
+template <typename Type>
+void Reserve(std::vector<Type>& v, size_t capacity) {
+    v.reserve(capacity);
+}
+
+template <typename Type>
+void Insert(SimpleVector<Type>& v, size_t index, Type&& value) {
+    v.Insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void Insert(std::vector<Type>& v, size_t index, Type&& value) {
+    v.insert(v.begin() + index, std::move(value));
+}
+
+template <typename Type>
+void Erase(SimpleVector<Type>& v, size_t index) {
+    v.Erase(v.begin() + index);
+}
+
+template <typename Type>
+void Erase(std::vector<Type>& v, size_t index) {
+    v.erase(v.begin() + index);
+}
+
+template <typename Type>
+void Resize(SimpleVector<Type>& v, size_t size) {
+    v.Resize(size);
+}
+
+template <typename Type>
+void Resize(std::vector<Type>& v, size_t size) {
+    v.resize(size);
+}
+
+template <typename Type>
+size_t Size(const SimpleVector<Type>& v) {
+    return v.GetSize();
+}
+
+template <typename Type>
+size_t Size(const std::vector<Type>& v) {
+    return v.size();
+}
+
+template <typename Container>
+using ValueType = std::decay_t<decltype(*std::declval<Container&>().begin())>;
+
+template <typename Container>
+Container MakeContainer(size_t size) {
+    Container v;
+    Reserve(v, size);
+    for (size_t i = 0; i < size; ++i) {
+        PushBack(v, MakeValue<ValueType<Container>>(i));
+    }
+    return v;
+}
+
+// Сбрасывает счётчики при создании и в деструкторе публикует их средние значения на итерацию
+class AllocationCounters {
+public:
+    explicit AllocationCounters(benchmark::State& state)
+        : state_(state)
+        , start_count_(allocation_count.load())
+        , start_bytes_(allocated_bytes.load()) {
+    }
+
+    ~AllocationCounters() {
+        const auto per_iteration = benchmark::Counter::kAvgIterations;
+        state_.counters["allocs"] = benchmark::Counter(
+                static_cast<double>(allocation_count.load() - start_count_), per_iteration);
+        state_.counters["bytes"] = benchmark::Counter(
+                static_cast<double>(allocated_bytes.load() - start_bytes_), per_iteration,
+                benchmark::Counter::kIs1024);
+    }
+
+private:
+    benchmark::State& state_;
+    size_t start_count_;
+    size_t start_bytes_;
+};
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    const size_t size = state.range(0);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Container v;
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, MakeValue<ValueType<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_PushBackReserved(benchmark::State& state) {
+    const size_t size = state.range(0);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Container v;
+        Reserve(v, size);
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(v, MakeValue<ValueType<Container>>(i));
+        }
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+// Позиция вставки и удаления: 0 — начало, 1 — середина, 2 — конец
+size_t PositionIndex(int64_t position, size_t size) {
+    return position == 0 ? 0 : position == 1 ? size / 2 : size;
+}
+
+// Каждая итерация вставляет и удаляет один элемент, так что размер остаётся постоянным
+template <typename Container>
+void BM_InsertErase(benchmark::State& state) {
+    const size_t size = state.range(0);
+    Container v = MakeContainer<Container>(size);
+    Reserve(v, size + 1);
+    const size_t index = PositionIndex(state.range(1), size);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Insert(v, index, MakeValue<ValueType<Container>>(size));
+        Erase(v, index);
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename Container>
+void BM_Resize(benchmark::State& state) {
+    const size_t size = state.range(0);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Container v;
+        Resize(v, size);
+        benchmark::DoNotOptimize(v.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_CopyConstruct(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const Container source = MakeContainer<Container>(size);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.begin());
+    }
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+template <typename Container>
+void BM_MoveConstruct(benchmark::State& state) {
+    const size_t size = state.range(0);
+    Container source = MakeContainer<Container>(size);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(moved.begin());
+        source = std::move(moved);
+    }
+}
+
+template <typename Container>
+void BM_Iterate(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const Container v = MakeContainer<Container>(size);
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        size_t checksum = 0;
+        for (const auto& item : v) {
+            benchmark::DoNotOptimize(&item);
+            ++checksum;
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * Size(v));
+}
+
+// Худший случай сравнения: векторы различаются только последним элементом
+template <typename Container>
+void BM_Compare(benchmark::State& state) {
+    const size_t size = state.range(0);
+    const Container lhs = MakeContainer<Container>(size);
+    Container rhs = MakeContainer<Container>(size);
+    Erase(rhs, size - 1);
+    PushBack(rhs, MakeValue<ValueType<Container>>(size));
+    AllocationCounters counters(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lhs == rhs);
+        benchmark::DoNotOptimize(lhs < rhs);
+    }
+    state.SetItemsProcessed(state.iterations() * size * 2);
+}
+
+constexpr int64_t kMinSize = 8;
+constexpr int64_t kMaxSize = 100'000'000;
+
+void Sizes(benchmark::internal::Benchmark* b) {
+    b->RangeMultiplier(16)->Range(kMinSize, kMaxSize)->Unit(benchmark::kMicrosecond);
+}
+
+void SizesAndPositions(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "pos"})
+     ->ArgsProduct({benchmark::CreateRange(kMinSize, kMaxSize, 16), {0, 1, 2}})
+     ->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+#define SIMPLE_VECTOR_BENCHMARK(Bench, Type, Args)                          \
+    BENCHMARK_TEMPLATE(Bench, SimpleVector<Type>)->Apply(Args);             \
+    BENCHMARK_TEMPLATE(Bench, std::vector<Type>)->Apply(Args)
+
+#define SIMPLE_VECTOR_BENCHMARKS_FOR_MOVABLE(Type)                          \
+    SIMPLE_VECTOR_BENCHMARK(BM_PushBack, Type, Sizes);                      \
+    SIMPLE_VECTOR_BENCHMARK(BM_PushBackReserved, Type, Sizes);              \
+    SIMPLE_VECTOR_BENCHMARK(BM_InsertErase, Type, SizesAndPositions);       \
+    SIMPLE_VECTOR_BENCHMARK(BM_Resize, Type, Sizes);                        \
+    SIMPLE_VECTOR_BENCHMARK(BM_MoveConstruct, Type, Sizes);                 \
+    SIMPLE_VECTOR_BENCHMARK(BM_Iterate, Type, Sizes)
+
+#define SIMPLE_VECTOR_BENCHMARKS_FOR_COPYABLE(Type)                         \
+    SIMPLE_VECTOR_BENCHMARKS_FOR_MOVABLE(Type);                             \
+    SIMPLE_VECTOR_BENCHMARK(BM_CopyConstruct, Type, Sizes);                 \
+    SIMPLE_VECTOR_BENCHMARK(BM_Compare, Type, Sizes)
+
+SIMPLE_VECTOR_BENCHMARKS_FOR_COPYABLE(int);
+SIMPLE_VECTOR_BENCHMARKS_FOR_COPYABLE(Pod64);
+SIMPLE_VECTOR_BENCHMARKS_FOR_COPYABLE(std::string);
+// X некопируем и не сравним, поэтому копирование и сравнение для него не измеряются
+SIMPLE_VECTOR_BENCHMARKS_FOR_MOVABLE(X);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,307 @@
+#pragma once
+
+// Вектор только для добавления, в который можно писать из многих потоков без блокировок.
+// Элементы лежат в сегментах, размеры которых растут вдвое, и никогда не переезжают:
+// ссылки и указатели на них остаются действительными до уничтожения вектора.
+// PushBack занимает индекс атомарным fetch_add и конструирует элемент в своём слоте
+// параллельно с остальными писателями. GetSize() — длина префикса уже сконструированных
+// элементов: читатели могут обходить [0, GetSize()) одновременно с добавлением.
+// Сам объект не копируется и не перемещается; уничтожать его можно, только когда
+// все писатели и читатели закончили
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <typename Type>
+class ConcurrentSimpleVector {
+    // Сегмент k вмещает kFirstSegmentSize << k элементов
+    static constexpr size_t kFirstSegmentShift = 5;
+    static constexpr size_t kFirstSegmentSize = size_t{1} << kFirstSegmentShift;
+    static constexpr size_t kMaxSegments = 64 - kFirstSegmentShift;
+
+    // Состояние слота; хранится байтом после элементов сегмента
+    enum : uint8_t {
+        kEmpty = 0,
+        kConstructed = 1,
+        kBroken = 2,  // конструктор элемента бросил исключение
+    };
+
+    template <typename Value>
+    class BasicIterator {
+        using VectorPtr = std::conditional_t<std::is_const_v<Value>, const ConcurrentSimpleVector*,
+                                             ConcurrentSimpleVector*>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        BasicIterator() noexcept = default;
+
+        reference operator*() const noexcept {
+            return (*vector_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*vector_)[index_];
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            SkipBroken();
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const BasicIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const BasicIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class ConcurrentSimpleVector;
+
+        BasicIterator(VectorPtr vector, size_t index, size_t end) noexcept
+            : vector_(vector)
+            , index_(index)
+            , end_(end) {
+            SkipBroken();
+        }
+
+        void SkipBroken() noexcept {
+            while (index_ < end_ && vector_->StateAt(index_) == kBroken) {
+                ++index_;
+            }
+        }
+
+        VectorPtr vector_ = nullptr;
+        size_t index_ = 0;
+        size_t end_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+
+    ConcurrentSimpleVector() noexcept = default;
+
+    ConcurrentSimpleVector(const ConcurrentSimpleVector&) = delete;
+    ConcurrentSimpleVector& operator=(const ConcurrentSimpleVector&) = delete;
+
+    ~ConcurrentSimpleVector() {
+        const size_t size = reserved_.load(std::memory_order_relaxed);
+        for (size_t index = 0; index < size; ++index) {
+            const auto [segment, offset] = Locate(index);
+            Type* items = segments_[segment].load(std::memory_order_relaxed);
+            // сегмента нет, если его выделение бросило std::bad_alloc
+            if (items != nullptr && States(items, segment)[offset].load() == kConstructed) {
+                std::destroy_at(items + offset);
+            }
+        }
+        for (size_t k = 0; k < kMaxSegments; ++k) {
+            if (Type* items = segments_[k].load(std::memory_order_relaxed)) {
+                FreeSegment(items, k);
+            }
+        }
+    }
+
+    // Возвращает длину префикса элементов, конструирование которых завершено.
+    // Добавленные позже элементы с большими индексами ещё могут быть не видны
+    size_t GetSize() const noexcept {
+        return published_.load(std::memory_order_acquire);
+    }
+
+    // Сообщает, пустой ли видимый префикс
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index. Индекс должен быть меньше GetSize()
+    // либо получен потоком от его собственного PushBack
+    Type& operator[](size_t index) noexcept {
+        const auto [segment, offset] = Locate(index);
+        return segments_[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        const auto [segment, offset] = Locate(index);
+        return segments_[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    // Заранее выделяет сегменты под capacity элементов. Можно вызывать одновременно с PushBack
+    void Reserve(size_t capacity) {
+        if (capacity == 0) {
+            return;
+        }
+        const size_t last = Locate(capacity - 1).first;
+        for (size_t k = 0; k <= last; ++k) {
+            Segment(k);
+        }
+    }
+
+    // Добавляет элемент в конец вектора и возвращает его индекс
+    size_t PushBack(const Type& item) {
+        return Append(item);
+    }
+
+    size_t PushBack(Type&& item) {
+        return Append(std::move(item));
+    }
+
+    // Конструирует элемент из args в конце вектора и возвращает ссылку на него.
+    // Если конструктор бросает исключение, занятый индекс остаётся пустым: его учитывает
+    // GetSize(), но обход пропускает, а обращаться к нему через operator[] нельзя.
+    // Если не удалось выделить сегмент, граница GetSize() дальше этого индекса не сдвинется
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return (*this)[Append(std::forward<Args>(args)...)];
+    }
+
+    // Итераторы обходят префикс, видимый в момент вызова begin() или end()
+
+    Iterator begin() noexcept {
+        return {this, 0, GetSize()};
+    }
+
+    Iterator end() noexcept {
+        const size_t size = GetSize();
+        return {this, size, size};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {this, 0, GetSize()};
+    }
+
+    ConstIterator end() const noexcept {
+        const size_t size = GetSize();
+        return {this, size, size};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // Номер сегмента и смещение в нём для индекса index
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const size_t biased = index + kFirstSegmentSize;
+        const size_t segment = HighestBit(biased) - kFirstSegmentShift;
+        return {segment, biased - (kFirstSegmentSize << segment)};
+    }
+
+    static size_t HighestBit(size_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+#else
+        size_t bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return kFirstSegmentSize << segment;
+    }
+
+    // Байты состояний слотов лежат сразу после элементов сегмента
+    static std::atomic<uint8_t>* States(Type* items, size_t segment) noexcept {
+        return reinterpret_cast<std::atomic<uint8_t>*>(items + SegmentSize(segment));
+    }
+
+    static size_t SegmentBytes(size_t segment) noexcept {
+        return SegmentSize(segment) * (sizeof(Type) + sizeof(std::atomic<uint8_t>));
+    }
+
+    uint8_t StateAt(size_t index) const noexcept {
+        const auto [segment, offset] = Locate(index);
+        return States(segments_[segment].load(), segment)[offset].load();
+    }
+
+    // Возвращает сегмент k, выделяя его при необходимости. Если несколько потоков выделили
+    // сегмент одновременно, остаётся первый, остальные освобождают свой
+    Type* Segment(size_t k) {
+        Type* items = segments_[k].load();
+        if (items != nullptr) {
+            return items;
+        }
+        Type* fresh = static_cast<Type*>(::operator new(SegmentBytes(k), std::align_val_t{alignof(Type)}));
+        std::atomic<uint8_t>* states = States(fresh, k);
+        for (size_t i = 0; i < SegmentSize(k); ++i) {
+            new (states + i) std::atomic<uint8_t>(kEmpty);
+        }
+        if (segments_[k].compare_exchange_strong(items, fresh)) {
+            return fresh;
+        }
+        FreeSegment(fresh, k);
+        return items;
+    }
+
+    static void FreeSegment(Type* items, size_t segment) noexcept {
+        ::operator delete(items, SegmentBytes(segment), std::align_val_t{alignof(Type)});
+    }
+
+    template <typename... Args>
+    size_t Append(Args&&... args) {
+        const size_t index = reserved_.fetch_add(1, std::memory_order_relaxed);
+        const auto [segment, offset] = Locate(index);
+        Type* items = Segment(segment);
+        std::atomic<uint8_t>& state = States(items, segment)[offset];
+        try {
+            new (items + offset) Type(std::forward<Args>(args)...);
+        } catch (...) {
+            state.store(kBroken);
+            Publish();
+            throw;
+        }
+        state.store(kConstructed);
+        Publish();
+        return index;
+    }
+
+    // Сдвигает границу видимого префикса через все готовые слоты. Так делает каждый писатель
+    // после своего элемента, поэтому граница не отстаёт от последнего завершённого писателя.
+    // Состояния и граница читаются и пишутся с memory_order_seq_cst: иначе два писателя
+    // соседних слотов могли бы не увидеть готовность друг друга, и граница бы застряла
+    void Publish() noexcept {
+        size_t published = published_.load();
+        for (;;) {
+            const auto [segment, offset] = Locate(published);
+            Type* items = segments_[segment].load();
+            if (items == nullptr || States(items, segment)[offset].load() == kEmpty) {
+                return;
+            }
+            // при неудаче published получает текущую границу
+            if (published_.compare_exchange_weak(published, published + 1)) {
+                ++published;
+            }
+        }
+    }
+
+    std::atomic<Type*> segments_[kMaxSegments] = {};
+    // Счётчики на разных строках кэша, чтобы занятие слотов не мешало читателям GetSize()
+    alignas(64) std::atomic<size_t> reserved_{0};
+    alignas(64) std::atomic<size_t> published_{0};
+};
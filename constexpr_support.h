@@ -0,0 +1,30 @@
+#pragma once
+
+// SIMPLE_VECTOR_CONSTEXPR помечает функции SimpleVector и ArrayPtr, которые в C++20 можно
+// вызывать в константных вычислениях: там разрешено временное выделение памяти через
+// std::allocator (P0784), а std::is_constant_evaluated позволяет заменить memmove, memcmp
+// и векторные инструкции поэлементными циклами. В C++17 макрос пуст.
+// Память, выделенная в константном вычислении, не может пережить его: чтобы таблица
+// попала в исполняемый файл готовой, её переносят в StaticSimpleVector (static_vector.h)
+
+#include <memory>
+#include <type_traits>
+
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+#define SIMPLE_VECTOR_CONSTEXPR constexpr
+#else
+#define SIMPLE_VECTOR_CONSTEXPR
+#endif
+
+namespace simple_vector_detail {
+
+// std::is_constant_evaluated(), а до C++20 — всегда false
+constexpr bool IsConstantEvaluated() noexcept {
+#if defined(__cpp_lib_is_constant_evaluated)
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+}  // namespace simple_vector_detail
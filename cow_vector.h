@@ -0,0 +1,317 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// Вектор с копированием при записи. Копии делят один буфер, и копирование сводится
+// к атомарному увеличению счётчика ссылок; буфер клонируется при первом изменяющем вызове
+// той копии, которая делит его с другими. Подходит для снимков, которые раздаются многим
+// потокам и почти не меняются.
+// Читающие методы константные и не клонируют буфер. Неконстантные operator[] и At, как и все
+// изменяющие методы, сначала делают буфер единоличным, поэтому ссылки и итераторы, полученные
+// до них, могут указывать в буфер, оставшийся у других копий.
+// Неконстантные operator[], At и Mutable помечают буфер неразделяемым, как это делали COW-строки:
+// пока выданная ими ссылка может быть жива, следующая копия клонирует элементы, а не делит буфер.
+// Любой другой изменяющий метод снимает пометку, так что ссылки от operator[], At и Mutable,
+// как и ссылки и итераторы, которые возвращают EmplaceBack, Insert и Erase, действительны
+// только до следующего изменения или копирования вектора.
+// Разные объекты, делящие буфер, можно читать, копировать и менять из разных потоков без
+// синхронизации; один и тот же объект — по обычным правилам, как SimpleVector
+template <typename Type, typename Alloc = std::allocator<Type>, typename Growth = DoublingGrowth>
+class CowSimpleVector {
+public:
+    using Vector = SimpleVector<Type, Alloc, Growth>;
+    using Iterator = typename Vector::Iterator;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    CowSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit CowSimpleVector(size_t size)
+        : CowSimpleVector(Vector(size)) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    CowSimpleVector(size_t size, const Type& value)
+        : CowSimpleVector(Vector(size, value)) {
+    }
+
+    // Создаёт вектор из std::initializer_list
+    CowSimpleVector(std::initializer_list<Type> init)
+        : CowSimpleVector(Vector(init)) {
+    }
+
+    // Забирает буфер вектора без копирования элементов
+    explicit CowSimpleVector(Vector&& items)
+        : shared_(new Shared{std::move(items)}) {
+    }
+
+    // Бросает исключение, только если буфер other неразделяемый и его приходится клонировать
+    CowSimpleVector(const CowSimpleVector& other)
+        : shared_(other.shared_) {
+        if (shared_ != nullptr && shared_->unshareable) {
+            shared_ = Clone(shared_->items, shared_->items.GetSize());
+        } else {
+            AddRef();
+        }
+    }
+
+    CowSimpleVector(CowSimpleVector&& other) noexcept
+        : shared_(std::exchange(other.shared_, nullptr)) {
+    }
+
+    ~CowSimpleVector() {
+        ReleaseRef(shared_);
+    }
+
+    CowSimpleVector& operator=(const CowSimpleVector& rhs) {
+        CowSimpleVector rhs_copy(rhs);
+        swap(rhs_copy);
+        return *this;
+    }
+
+    CowSimpleVector& operator=(CowSimpleVector&& rhs) noexcept {
+        CowSimpleVector rhs_copy(std::move(rhs));
+        swap(rhs_copy);
+        return *this;
+    }
+
+    // Возвращает количество элементов в векторе
+    size_t GetSize() const noexcept {
+        return shared_ != nullptr ? shared_->items.GetSize() : 0;
+    }
+
+    // Возвращает вместимость общего буфера
+    size_t GetCapacity() const noexcept {
+        return shared_ != nullptr ? shared_->items.GetCapacity() : 0;
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Сообщает, делит ли вектор буфер с другими копиями
+    bool IsShared() const noexcept {
+        return shared_ != nullptr && shared_->refs.load(std::memory_order_acquire) > 1;
+    }
+
+    // Только для чтения: сами элементы, без клонирования
+    const Vector& Get() const noexcept {
+        return shared_ != nullptr ? shared_->items : EmptyVector();
+    }
+
+    // Делает буфер единоличным и возвращает его для изменения.
+    // Ссылка действительна до следующего изменяющего вызова этого объекта
+    Vector& Mutable() {
+        return Leak(GetSize());
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return Get()[index];
+    }
+
+    // Неконстантный доступ клонирует общий буфер
+    Type& operator[](size_t index) {
+        return Leak(GetSize())[index];
+    }
+
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        return Get().At(index);
+    }
+
+    Type& At(size_t index) {
+        if (index >= GetSize())
+            throw std::out_of_range{"index >= size"};
+        return Leak(GetSize())[index];
+    }
+
+    // Итераторы только константные: неконстантный обход клонировал бы буфер.
+    // Для изменения элементов на месте — Mutable()
+
+    ConstIterator begin() const noexcept {
+        return Get().begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return Get().end();
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Увеличивает вместимость; общий буфер клонируется сразу с новой вместимостью
+    void Reserve(size_t new_capacity) {
+        Modify(new_capacity).Reserve(new_capacity);
+    }
+
+    // Очищает вектор. Общий буфер не клонируется, а просто отпускается
+    void Clear() noexcept {
+        if (IsShared()) {
+            ReleaseRef(std::exchange(shared_, nullptr));
+        } else if (shared_ != nullptr) {
+            shared_->items.Clear();
+            shared_->unshareable = false;
+        }
+    }
+
+    // Изменяет размер массива
+    void Resize(size_t new_size) {
+        Modify(new_size).Resize(new_size);
+    }
+
+    // Добавляет элемент в конец вектора
+    void PushBack(const Type& item) {
+        Modify(GetSize() + 1).PushBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        Modify(GetSize() + 1).PushBack(std::move(item));
+    }
+
+    // Конструирует элемент из args в конце вектора и возвращает ссылку на него.
+    // args могут ссылаться на элементы этого вектора: общий буфер при клонировании
+    // остаётся у других копий, а единоличный SimpleVector сам учитывает такие ссылки
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        return Modify(GetSize() + 1).EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Вставляет value перед pos; pos может указывать в общий буфер
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        const size_t index = pos - begin();
+        Vector& items = Modify(GetSize() + 1);
+        return items.Insert(items.begin() + index, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        const size_t index = pos - begin();
+        Vector& items = Modify(GetSize() + 1);
+        return items.Insert(items.begin() + index, std::move(value));
+    }
+
+    // Удаляет элемент в позиции pos; pos может указывать в общий буфер
+    Iterator Erase(ConstIterator pos) {
+        const size_t index = pos - begin();
+        Vector& items = Modify(GetSize());
+        return items.Erase(items.begin() + index);
+    }
+
+    Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t index = first - begin();
+        const size_t count = last - first;
+        Vector& items = Modify(GetSize());
+        return items.Erase(items.begin() + index, items.begin() + index + count);
+    }
+
+    // Удаляет последний элемент. Вектор не должен быть пустым
+    void PopBack() {
+        Modify(GetSize()).PopBack();
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(CowSimpleVector& other) noexcept {
+        std::swap(shared_, other.shared_);
+    }
+
+    // Копии одного буфера равны без сравнения элементов
+
+    friend bool operator==(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return lhs.shared_ == rhs.shared_ || lhs.Get() == rhs.Get();
+    }
+
+    friend bool operator!=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return lhs.shared_ != rhs.shared_ && lhs.Get() < rhs.Get();
+    }
+
+    friend bool operator<=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend bool operator>(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return rhs < lhs;
+    }
+
+    friend bool operator>=(const CowSimpleVector& lhs, const CowSimpleVector& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    struct Shared {
+        Vector items;
+        std::atomic<size_t> refs{1};
+        // Наружу выдана изменяемая ссылка на элемент. Меняется только при refs == 1,
+        // то есть единственным владельцем, поэтому атомарность не нужна
+        bool unshareable = false;
+    };
+
+    static const Vector& EmptyVector() noexcept {
+        static const Vector empty;
+        return empty;
+    }
+
+    void AddRef() const noexcept {
+        if (shared_ != nullptr) {
+            shared_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // acq_rel: последний владелец должен видеть все чтения и записи остальных до удаления
+    static void ReleaseRef(Shared* shared) noexcept {
+        if (shared != nullptr && shared->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared;
+        }
+    }
+
+    // Новый единоличный буфер с копией items и вместимостью не меньше capacity
+    static Shared* Clone(const Vector& items, size_t capacity) {
+        Vector clone(::Reserve(std::max(capacity, items.GetSize())),
+                     std::allocator_traits<Alloc>::select_on_container_copy_construction(items.GetAllocator()));
+        clone.Append(items.begin(), items.end());
+        return new Shared{std::move(clone)};
+    }
+
+    // Делает буфер единоличным, клонируя общий с вместимостью не меньше capacity.
+    // Строгая гарантия: при исключении во время клонирования вектор не меняется
+    Vector& Detach(size_t capacity) {
+        if (shared_ == nullptr) {
+            shared_ = new Shared{Vector()};
+        } else if (shared_->refs.load(std::memory_order_acquire) != 1) {
+            ReleaseRef(std::exchange(shared_, Clone(shared_->items, capacity)));
+        }
+        return shared_->items;
+    }
+
+    // Как Detach, но ещё и помечает буфер неразделяемым перед выдачей изменяемой ссылки
+    Vector& Leak(size_t capacity) {
+        Vector& items = Detach(capacity);
+        shared_->unshareable = true;
+        return items;
+    }
+
+    // Как Detach для изменения, после которого ранее выданные ссылки недействительны:
+    // буфер снова можно делить
+    Vector& Modify(size_t capacity) {
+        Vector& items = Detach(capacity);
+        shared_->unshareable = false;
+        return items;
+    }
+
+    Shared* shared_ = nullptr;
+};
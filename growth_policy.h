@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+// Стратегии роста вместимости SimpleVector.
+// Стратегия — тип со статической функцией
+//     template <typename Type> static size_t NextCapacity(size_t capacity, size_t required);
+// возвращающей новую вместимость не меньше required, и флагом kTryExpandInPlace:
+// если он установлен, перед переносом элементов вектор просит аллокатор
+// расширить текущий блок на месте (см. ArrayPtr::TryExpand)
+
+// Рост вдвое; для пустого вектора вместимость становится равной required
+struct DoublingGrowth {
+    static constexpr bool kTryExpandInPlace = false;
+
+    template <typename Type>
+    static constexpr size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        return std::max(capacity * 2, required);
+    }
+};
+
+// Рост в 1.5 раза. Сумма ранее освобождённых блоков рано или поздно превышает
+// следующий запрос, и аллокатор может переиспользовать эту память
+struct OneAndHalfGrowth {
+    static constexpr bool kTryExpandInPlace = false;
+
+    template <typename Type>
+    static constexpr size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        return std::max(capacity + capacity / 2, required);
+    }
+};
+
+// Округляет вместимость, выбранную Base, вверх до размерного класса аллокатора,
+// чтобы не терять хвост блока, который malloc всё равно выделит.
+// Классы устроены как в jemalloc/tcmalloc/mimalloc: по четыре на каждую степень двойки,
+// не меньше 16 байт, а начиная с размера страницы кратны странице
+template <typename Base = DoublingGrowth>
+struct SizeClassGrowth {
+    static constexpr bool kTryExpandInPlace = Base::kTryExpandInPlace;
+
+    template <typename Type>
+    static constexpr size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        const size_t target = Base::template NextCapacity<Type>(capacity, required);
+        if (target > static_cast<size_t>(-1) / sizeof(Type) / 2) {
+            return target;
+        }
+        return std::max(RoundToSizeClass(target * sizeof(Type)) / sizeof(Type), target);
+    }
+
+    static constexpr size_t RoundToSizeClass(size_t bytes) noexcept {
+        constexpr size_t kMinClass = 16;
+        constexpr size_t kPageSize = 4096;
+        if (bytes <= kMinClass) {
+            return kMinClass;
+        }
+        size_t power = kMinClass;
+        while (power * 2 < bytes) {
+            power *= 2;
+        }
+        const size_t step = std::max(power / 4, bytes >= kPageSize ? kPageSize : size_t{1});
+        return (bytes + step - 1) / step * step;
+    }
+};
+
+// Та же стратегия Base, но перед переносом элементов вектор сначала пытается расширить блок на месте
+template <typename Base = DoublingGrowth>
+struct InPlaceFirstGrowth : Base {
+    static constexpr bool kTryExpandInPlace = true;
+};
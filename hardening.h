@@ -0,0 +1,240 @@
+#pragma once
+#include "constexpr_support.h"
+
+// Уровень проверок задаётся при компиляции макросом SIMPLE_VECTOR_HARDENING
+// (-DSIMPLE_VECTOR_HARDENING=1) и должен совпадать во всех единицах трансляции:
+//   0 — по умолчанию: индексы и позиции проверяет только assert, то есть только без NDEBUG;
+//   1 — те же проверки в SimpleVector, SmallSimpleVector, StaticSimpleVector, SegmentedSimpleVector,
+//       MappedSimpleVector и представлениях остаются и с NDEBUG; CowSimpleVector и SoASimpleVector
+//       проверяются через SimpleVector внутри. ConcurrentSimpleVector индексы не проверяет:
+//       поток вправе обратиться к своему элементу до того, как его учтёт GetSize().
+//       Проверка — одно сравнение, а ветка сбоя вынесена в холодную функцию, поэтому
+//       горячий цикл почти не замедляется. Годится для канареек;
+//   2 — вдобавок итераторы SimpleVector несут номер поколения буфера и ловят обращение через
+//       итератор, устаревший после перевыделения памяти, а также выход за границы.
+//       Итераторы перестают быть указателями, поэтому это отладочный режим.
+// Нарушение печатает сообщение в stderr и вызывает std::abort()
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+#ifndef SIMPLE_VECTOR_HARDENING
+#define SIMPLE_VECTOR_HARDENING 0
+#endif
+
+#if defined(__has_cpp_attribute) && __cplusplus >= 202002L
+#if __has_cpp_attribute(unlikely)
+#define SIMPLE_VECTOR_UNLIKELY [[unlikely]]
+#endif
+#endif
+#ifndef SIMPLE_VECTOR_UNLIKELY
+#define SIMPLE_VECTOR_UNLIKELY
+#endif
+
+#if defined(__GNUC__)
+#define SIMPLE_VECTOR_COLD __attribute__((cold, noinline))
+#else
+#define SIMPLE_VECTOR_COLD
+#endif
+
+namespace simple_vector_detail {
+
+[[noreturn]] SIMPLE_VECTOR_COLD inline void HardeningFailure(const char* message, const char* file, int line) noexcept {
+    std::fprintf(stderr, "%s:%d: SimpleVector check failed: %s\n", file, line, message);
+    std::abort();
+}
+
+#if SIMPLE_VECTOR_HARDENING >= 2
+inline std::atomic<size_t> next_generation{1};
+
+// Номер поколения для нового буфера. Счётчик общий для всех векторов, поэтому итератор
+// уничтоженного вектора не совпадёт с вектором, созданным на его месте
+SIMPLE_VECTOR_CONSTEXPR inline size_t NextGeneration() noexcept {
+    if (IsConstantEvaluated()) {
+        return 0;
+    }
+    return next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+#endif
+
+}  // namespace simple_vector_detail
+
+// SIMPLE_VECTOR_CHECK(cond, message) — проверка входных данных: индексов, позиций, размеров
+#if SIMPLE_VECTOR_HARDENING >= 1
+#define SIMPLE_VECTOR_CHECK(cond, message)                                                   \
+    do {                                                                                     \
+        if (!(cond)) SIMPLE_VECTOR_UNLIKELY {                                                \
+            ::simple_vector_detail::HardeningFailure(message, __FILE__, __LINE__);           \
+        }                                                                                    \
+    } while (false)
+#else
+#define SIMPLE_VECTOR_CHECK(cond, message) assert((cond) && message)
+#endif
+
+#if SIMPLE_VECTOR_HARDENING >= 2
+// Итератор SimpleVector на уровне 2. Кроме указателя хранит вектор-владелец и поколение его
+// буфера на момент получения итератора. Разыменование проверяет, что буфер с тех пор не
+// перевыделялся и элемент лежит в [begin, end); вычитание и сравнение — что итераторы
+// относятся к одному вектору. Перевыделением считаются рост с переносом элементов,
+// ShrinkToFit, ClearAndRelease, Adopt, ReleaseBuffer, а также перемещение и обмен векторов:
+// в отличие от std::vector, итераторы после них недействительны.
+// Owner — вектор, который обращается к итератору через Data(), size_ и generation_
+template <typename Type, typename Owner>
+class CheckedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_const_t<Type>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Type*;
+    using reference = Type&;
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator() noexcept = default;
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator(Type* ptr, const Owner* owner) noexcept
+        : ptr_(ptr)
+        , owner_(owner)
+        , generation_(owner->generation_) {
+    }
+
+    // Изменяемый итератор приводится к константному
+    template <typename Other, typename = std::enable_if_t<std::is_same_v<const Other, Type>
+                                                          && !std::is_same_v<Other, Type>>>
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator(const CheckedIterator<Other, Owner>& other) noexcept
+        : ptr_(other.ptr_)
+        , owner_(other.owner_)
+        , generation_(other.generation_) {
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR reference operator*() const noexcept {
+        CheckDereferenceable();
+        return *ptr_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR pointer operator->() const noexcept {
+        CheckDereferenceable();
+        return ptr_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator++() noexcept {
+        ++ptr_;
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator++(int) noexcept {
+        CheckedIterator old = *this;
+        ++ptr_;
+        return old;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator--() noexcept {
+        --ptr_;
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator--(int) noexcept {
+        CheckedIterator old = *this;
+        --ptr_;
+        return old;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator+=(difference_type n) noexcept {
+        ptr_ += n;
+        return *this;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR CheckedIterator& operator-=(difference_type n) noexcept {
+        ptr_ -= n;
+        return *this;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator+(CheckedIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator+(difference_type n, CheckedIterator it) noexcept {
+        return it += n;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR CheckedIterator operator-(CheckedIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR difference_type operator-(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ - rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator==(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ == rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator!=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        lhs.CheckComparable(rhs);
+        return lhs.ptr_ < rhs.ptr_;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(rhs < lhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return rhs < lhs;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>=(const CheckedIterator& lhs, const CheckedIterator& rhs) noexcept {
+        return !(lhs < rhs);
+    }
+
+    // Проверяет, что итератор получен от owner после последнего перевыделения и указывает
+    // в [begin, end]. Так вектор проверяет позиции, переданные в Insert и Erase
+    SIMPLE_VECTOR_CONSTEXPR void CheckPosition(const Owner* owner) const noexcept {
+        SIMPLE_VECTOR_CHECK(owner_ == owner, "iterator belongs to another vector");
+        CheckCurrent();
+        SIMPLE_VECTOR_CHECK(owner_->Data() <= ptr_ && ptr_ <= owner_->Data() + owner_->size_,
+                            "iterator out of range");
+    }
+
+    // Указатель без проверок, например для передачи в memcpy
+    SIMPLE_VECTOR_CONSTEXPR pointer Get() const noexcept {
+        return ptr_;
+    }
+
+private:
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckCurrent() const noexcept {
+        SIMPLE_VECTOR_CHECK(owner_ != nullptr, "singular iterator");
+        SIMPLE_VECTOR_CHECK(owner_->generation_ == generation_, "iterator invalidated by reallocation");
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckDereferenceable() const noexcept {
+        CheckCurrent();
+        SIMPLE_VECTOR_CHECK(owner_->Data() <= ptr_ && ptr_ < owner_->Data() + owner_->size_,
+                            "dereferenced iterator out of range");
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void CheckComparable(const CheckedIterator& other) const noexcept {
+        SIMPLE_VECTOR_CHECK(owner_ == other.owner_, "comparing iterators of different vectors");
+        SIMPLE_VECTOR_CHECK(generation_ == other.generation_, "comparing iterators of different buffers");
+    }
+
+    Type* ptr_ = nullptr;
+    const Owner* owner_ = nullptr;
+    size_t generation_ = 0;
+};
+#endif
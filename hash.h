@@ -0,0 +1,391 @@
+#pragma once
+#include "simple_vector.h"
+#include "simple_vector_view.h"
+
+// Хеширование векторов, чтобы использовать их как ключи std::unordered_map.
+// Элементы, равенство которых совпадает с побайтовым (целые, перечисления, указатели и
+// структуры из них без заполнения, см. std::has_unique_object_representations), хешируются
+// одним проходом по буферу, как в wyhash: по 48 байт за шаг тремя независимыми цепочками
+// умножений 64×64→128. Остальные — по одному элементу через std::hash, иначе, например,
+// 0.0 и -0.0 или структуры с разным мусором в заполнении получили бы разные хеши.
+// Значения хешей зависят от платформы и не предназначены для сохранения
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace hash_detail {
+
+constexpr uint64_t kSecret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+                                 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+#if defined(__SIZEOF_INT128__)
+// __extension__ снимает предупреждение -Wpedantic о нестандартном типе
+__extension__ using UInt128 = unsigned __int128;
+#endif
+
+// Полное 128-битное произведение: младшая половина в a, старшая в b
+constexpr void Multiply(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const UInt128 r = static_cast<UInt128>(a) * b;
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64);
+#else
+    const uint64_t a_lo = a & 0xffffffffu, a_hi = a >> 32;
+    const uint64_t b_lo = b & 0xffffffffu, b_hi = b >> 32;
+    const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+    a = (cross << 32) | (lo_lo & 0xffffffffu);
+    b = hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+constexpr uint64_t Mix(uint64_t a, uint64_t b) noexcept {
+    Multiply(a, b);
+    return a ^ b;
+}
+
+inline uint64_t Read8(const unsigned char* p) noexcept {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t Read4(const unsigned char* p) noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+template <typename Type>
+constexpr bool kHashAsBytes = std::has_unique_object_representations_v<Type>;
+
+// Арифметика по модулю простого 2^61 - 1 для IncrementalHash
+constexpr uint64_t kModulus = (uint64_t{1} << 61) - 1;
+
+constexpr uint64_t Reduce(uint64_t value) noexcept {
+    return value >= kModulus ? value - kModulus : value;
+}
+
+constexpr uint64_t AddMod(uint64_t a, uint64_t b) noexcept {
+    return Reduce(a + b);
+}
+
+constexpr uint64_t SubMod(uint64_t a, uint64_t b) noexcept {
+    return Reduce(a + kModulus - b);
+}
+
+// a · b для a, b < 2^61: так как 2^61 ≡ 1, старшие биты произведения складываются с младшими
+constexpr uint64_t MulMod(uint64_t a, uint64_t b) noexcept {
+    Multiply(a, b);
+    return Reduce(Reduce((a & kModulus) + (a >> 61)) + (b << 3));
+}
+
+constexpr uint64_t PowMod(uint64_t base, uint64_t exponent) noexcept {
+    uint64_t result = 1;
+    for (; exponent > 0; exponent >>= 1) {
+        if (exponent & 1) {
+            result = MulMod(result, base);
+        }
+        base = MulMod(base, base);
+    }
+    return result;
+}
+
+constexpr uint64_t kBase = 0x16a09e667f3bcc9ull;
+
+// Обратный к kBase по малой теореме Ферма
+constexpr uint64_t kInverseBase = PowMod(kBase, kModulus - 2);
+
+static_assert(MulMod(kBase, kInverseBase) == 1);
+
+}  // namespace hash_detail
+
+// Хеш size байт по адресу data (алгоритм wyhash)
+inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0) noexcept {
+    using namespace hash_detail;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    if (size <= 16) {
+        if (size >= 4) {
+            const size_t middle = (size >> 3) << 2;
+            a = (Read4(p) << 32) | Read4(p + middle);
+            b = (Read4(p + size - 4) << 32) | Read4(p + size - 4 - middle);
+        } else if (size > 0) {
+            a = (uint64_t{p[0]} << 16) | (uint64_t{p[size >> 1]} << 8) | p[size - 1];
+        }
+    } else {
+        size_t left = size;
+        if (left >= 48) {
+            uint64_t seed1 = seed;
+            uint64_t seed2 = seed;
+            do {
+                seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+                seed1 = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ seed1);
+                seed2 = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ seed2);
+                p += 48;
+                left -= 48;
+            } while (left >= 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (left > 16) {
+            seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+            p += 16;
+            left -= 16;
+        }
+        a = Read8(p + left - 16);
+        b = Read8(p + left - 8);
+    }
+    a ^= kSecret[1];
+    b ^= seed;
+    Multiply(a, b);
+    return Mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+}
+
+// Хеш одного элемента: байты для типов с однозначным представлением, иначе std::hash
+template <typename Type>
+uint64_t HashElement(const Type& item) noexcept {
+    if constexpr (hash_detail::kHashAsBytes<Type>) {
+        return HashBytes(&item, sizeof(Type));
+    } else {
+        return hash_detail::Mix(std::hash<Type>{}(item) ^ hash_detail::kSecret[0], hash_detail::kSecret[2]);
+    }
+}
+
+// Хеш последовательности элементов; равные по == последовательности получают равные хеши
+template <typename Type>
+uint64_t HashElements(const Type* data, size_t size) noexcept {
+    if constexpr (hash_detail::kHashAsBytes<Type>) {
+        return HashBytes(data, size * sizeof(Type));
+    } else {
+        uint64_t hash = hash_detail::kSecret[0];
+        for (size_t i = 0; i < size; ++i) {
+            hash = hash_detail::Mix(hash ^ hash_detail::kSecret[1], HashElement(data[i]));
+        }
+        return hash_detail::Mix(hash ^ size, hash_detail::kSecret[3]);
+    }
+}
+
+// Функтор для любого непрерывного диапазона: SimpleVector, SmallSimpleVector, представлений
+struct SimpleVectorHash {
+    template <typename Range>
+    size_t operator()(const Range& range) const noexcept {
+        const SimpleVectorView view(range);
+        return static_cast<size_t>(HashElements(view.begin(), view.GetSize()));
+    }
+};
+
+namespace std {
+
+template <typename Type, typename Alloc, typename Growth>
+struct hash<SimpleVector<Type, Alloc, Growth>> : SimpleVectorHash {};
+
+template <typename Type>
+struct hash<SimpleVectorView<Type>> : SimpleVectorHash {};
+
+}  // namespace std
+
+// Полиномиальный хеш, который пересчитывается за O(1) при добавлении элемента в конец
+// и удалении с любого края: H = Σ (h(items[i]) mod P + 1) · B^i mod P, где P = 2^61 - 1, а h — HashElement.
+// Нужен для ключей, которые строятся по одному элементу, например n-грамм в скользящем окне,
+// где полный пересчёт стоил бы O(n) на каждый шаг. Значение отличается от std::hash
+template <typename Type>
+class IncrementalHash {
+public:
+    // Хеш пустой последовательности
+    IncrementalHash() noexcept = default;
+
+    // Хеш всех элементов диапазона
+    template <typename Range>
+    static IncrementalHash Of(const Range& range) noexcept {
+        IncrementalHash hash;
+        for (const Type& item : SimpleVectorConstView<Type>(range)) {
+            hash.Append(item);
+        }
+        return hash;
+    }
+
+    // Учитывает item, добавленный в конец
+    void Append(const Type& item) noexcept {
+        sum_ = hash_detail::AddMod(sum_, hash_detail::MulMod(Digit(item), power_));
+        power_ = hash_detail::MulMod(power_, hash_detail::kBase);
+        ++size_;
+    }
+
+    // Учитывает удаление последнего элемента, равного item
+    void RemoveBack(const Type& item) noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "RemoveBack on empty hash");
+        power_ = hash_detail::MulMod(power_, hash_detail::kInverseBase);
+        sum_ = hash_detail::SubMod(sum_, hash_detail::MulMod(Digit(item), power_));
+        --size_;
+    }
+
+    // Учитывает удаление первого элемента, равного item: так окно сдвигается на один элемент
+    void RemoveFront(const Type& item) noexcept {
+        SIMPLE_VECTOR_CHECK(size_ > 0, "RemoveFront on empty hash");
+        using namespace hash_detail;
+        sum_ = MulMod(SubMod(sum_, Digit(item)), kInverseBase);
+        power_ = MulMod(power_, kInverseBase);
+        --size_;
+    }
+
+    // Учитывает замену элемента с индексом index со старого значения old_item на new_item
+    void Replace(size_t index, const Type& old_item, const Type& new_item) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        using namespace hash_detail;
+        const uint64_t power = PowMod(kBase, index);
+        sum_ = AddMod(SubMod(sum_, MulMod(Digit(old_item), power)), MulMod(Digit(new_item), power));
+    }
+
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Итоговый хеш; у равных последовательностей он равен
+    size_t Get() const noexcept {
+        return static_cast<size_t>(hash_detail::Mix(sum_ ^ hash_detail::kSecret[0], size_ ^ hash_detail::kSecret[1]));
+    }
+
+    friend bool operator==(const IncrementalHash& lhs, const IncrementalHash& rhs) noexcept {
+        return lhs.sum_ == rhs.sum_ && lhs.size_ == rhs.size_;
+    }
+
+    friend bool operator!=(const IncrementalHash& lhs, const IncrementalHash& rhs) noexcept {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Ненулевой остаток хеша элемента, чтобы добавление любого элемента меняло сумму
+    static uint64_t Digit(const Type& item) noexcept {
+        return HashElement(item) % (hash_detail::kModulus - 1) + 1;
+    }
+
+    uint64_t sum_ = 0;
+    uint64_t power_ = 1;
+    size_t size_ = 0;
+};
+
+// Вектор, который поддерживает свой IncrementalHash при каждом изменении, поэтому
+// std::hash для него стоит O(1). Элементы меняются только через методы ниже;
+// для чтения доступны константные итераторы и Get()
+template <typename Type, typename Alloc = std::allocator<Type>, typename Growth = DoublingGrowth>
+class HashedSimpleVector {
+public:
+    using Vector = SimpleVector<Type, Alloc, Growth>;
+    using ConstIterator = typename Vector::ConstIterator;
+
+    HashedSimpleVector() = default;
+
+    // Забирает буфер вектора и считает хеш его элементов
+    explicit HashedSimpleVector(Vector&& items) noexcept
+        : items_(std::move(items))
+        , hash_(IncrementalHash<Type>::Of(items_)) {
+    }
+
+    HashedSimpleVector(std::initializer_list<Type> init)
+        : HashedSimpleVector(Vector(init)) {
+    }
+
+    size_t GetSize() const noexcept {
+        return items_.GetSize();
+    }
+
+    bool IsEmpty() const noexcept {
+        return items_.IsEmpty();
+    }
+
+    const Vector& Get() const noexcept {
+        return items_;
+    }
+
+    const Type& operator[](size_t index) const noexcept {
+        return items_[index];
+    }
+
+    ConstIterator begin() const noexcept {
+        return items_.begin();
+    }
+
+    ConstIterator end() const noexcept {
+        return items_.end();
+    }
+
+    // Хеш элементов за O(1)
+    size_t GetHash() const noexcept {
+        return hash_.Get();
+    }
+
+    void Reserve(size_t new_capacity) {
+        items_.Reserve(new_capacity);
+    }
+
+    // Строгая гарантия, как у SimpleVector::PushBack
+    void PushBack(const Type& item) {
+        items_.PushBack(item);
+        hash_.Append(items_[items_.GetSize() - 1]);
+    }
+
+    void PushBack(Type&& item) {
+        items_.PushBack(std::move(item));
+        hash_.Append(items_[items_.GetSize() - 1]);
+    }
+
+    // Удаляет последний элемент. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        hash_.RemoveBack(items_[items_.GetSize() - 1]);
+        items_.PopBack();
+    }
+
+    // Присваивает элементу с индексом index значение value
+    void Set(size_t index, Type value) {
+        Type& item = items_[index];
+        hash_.Replace(index, item, value);
+        item = std::move(value);
+    }
+
+    void Clear() noexcept {
+        items_.Clear();
+        hash_ = {};
+    }
+
+    // Отдаёт вектор, оставляя этот пустым
+    Vector Release() noexcept {
+        hash_ = {};
+        return std::move(items_);
+    }
+
+    void swap(HashedSimpleVector& other) noexcept {
+        items_.swap(other.items_);
+        std::swap(hash_, other.hash_);
+    }
+
+    // Разные хеши означают разные элементы, поэтому сравнение элементов нужно только при равных
+    friend bool operator==(const HashedSimpleVector& lhs, const HashedSimpleVector& rhs) {
+        return lhs.hash_ == rhs.hash_ && lhs.items_ == rhs.items_;
+    }
+
+    friend bool operator!=(const HashedSimpleVector& lhs, const HashedSimpleVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    Vector items_;
+    IncrementalHash<Type> hash_;
+};
+
+namespace std {
+
+template <typename Type, typename Alloc, typename Growth>
+struct hash<HashedSimpleVector<Type, Alloc, Growth>> {
+    size_t operator()(const HashedSimpleVector<Type, Alloc, Growth>& v) const noexcept {
+        return v.GetHash();
+    }
+};
+
+}  // namespace std
@@ -1,8 +1,43 @@
+#include "algorithms.h"
+#include "aligned_allocator.h"
+#include "arena_allocator.h"
+#include "concurrent_vector.h"
+#include "cow_vector.h"
+#include "hash.h"
+#include "malloc_allocator.h"
+#include "mapped_vector.h"
+#include "segmented_vector.h"
+#include "serialize.h"
 #include "simple_vector.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "static_vector.h"
 
+#include <atomic>
 #include <cassert>
+#include <csignal>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
 #include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <sys/wait.h>
 
 using namespace std;
 
@@ -31,6 +66,64 @@ private:
     size_t x_;
 };
 
+// Считает живые экземпляры, чтобы проверять, какие элементы вектор реально создаёт
+class Counted {
+public:
+    Counted() {
+        ++alive;
+    }
+    Counted(const Counted&) {
+        ++alive;
+    }
+    Counted(Counted&&) noexcept {
+        ++alive;
+    }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() {
+        --alive;
+    }
+
+    static inline int alive = 0;
+};
+
+// Считает живые экземпляры и бросает из перемещающего присваивания, когда assigns_left доходит до нуля
+class ThrowingAssign {
+public:
+    explicit ThrowingAssign(int value = 0)
+        : value_(value) {
+        ++alive;
+    }
+    ThrowingAssign(const ThrowingAssign& other)
+        : value_(other.value_) {
+        ++alive;
+    }
+    ThrowingAssign(ThrowingAssign&& other) noexcept
+        : value_(other.value_) {
+        ++alive;
+    }
+    ThrowingAssign& operator=(const ThrowingAssign& other) = default;
+    ThrowingAssign& operator=(ThrowingAssign&& other) {
+        if (assigns_left-- == 0) {
+            throw runtime_error("assign");
+        }
+        value_ = other.value_;
+        return *this;
+    }
+    ~ThrowingAssign() {
+        --alive;
+    }
+    int GetValue() const {
+        return value_;
+    }
+
+    static inline int alive = 0;
+    static inline int assigns_left = numeric_limits<int>::max();
+
+private:
+    int value_;
+};
+
 SimpleVector<int> GenerateVector(size_t size) {
     SimpleVector<int> v(size);
     iota(v.begin(), v.end(), 1);
@@ -149,6 +242,1700 @@ void TestNoncopiableErase() {
     cout << "Done!" << endl << endl;
 }
 
+void TestUninitializedStorage() {
+    cout << "Test uninitialized storage" << endl;
+    {
+        SimpleVector<Counted> v(Reserve(1000));
+        assert(v.GetCapacity() == 1000);
+        assert(Counted::alive == 0);
+
+        v.Reserve(2000);
+        assert(Counted::alive == 0);
+
+        v.Resize(10);
+        assert(Counted::alive == 10);
+        v.PopBack();
+        assert(Counted::alive == 9);
+        v.Erase(v.begin());
+        assert(Counted::alive == 8);
+        v.PushBack(Counted{});
+        assert(Counted::alive == 9);
+        v.Resize(3);
+        assert(Counted::alive == 3);
+        v.Clear();
+        assert(Counted::alive == 0);
+        assert(v.GetCapacity() == 2000);
+        v.Resize(5);
+    }
+    assert(Counted::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestEmplace() {
+    cout << "Test emplace" << endl;
+    SimpleVector<X> v;
+    [[maybe_unused]] const size_t first = v.EmplaceBack(1).GetX();
+    assert(first == 1);
+    assert(v.GetCapacity() == 1);
+    [[maybe_unused]] const size_t second = v.EmplaceBack(3).GetX();
+    assert(second == 3);
+    assert(v.GetCapacity() == 2);
+
+    [[maybe_unused]] auto it = v.Emplace(v.begin() + 1, 2);
+    assert(it == v.begin() + 1);
+    assert(v.GetCapacity() == 4);
+    it = v.Emplace(v.begin(), 0);
+    assert(it == v.begin());
+    for (size_t i = 0; i < v.GetSize(); ++i) {
+        assert(v[i].GetX() == i);
+    }
+
+    SimpleVector<SimpleVector<int>> vv;
+    vv.EmplaceBack(3, 7);
+    vv.Emplace(vv.begin(), 2, 1);
+    assert(vv.GetSize() == 2);
+    assert((vv[0] == SimpleVector<int>{1, 1}));
+    assert((vv[1] == SimpleVector<int>{7, 7, 7}));
+
+    // исключение при сдвиге внутри ёмкости не должно терять уже созданный последний элемент
+    {
+        SimpleVector<ThrowingAssign> throwing(Reserve(8));
+        for (int i = 0; i < 4; ++i) {
+            throwing.EmplaceBack(i);
+        }
+        ThrowingAssign::assigns_left = 1;
+        try {
+            throwing.Emplace(throwing.begin() + 1, 10);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingAssign::assigns_left = numeric_limits<int>::max();
+        assert(throwing.GetSize() == 5);
+        assert(ThrowingAssign::alive == 5);
+    }
+    assert(ThrowingAssign::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+void TestPolymorphicAllocator() {
+    cout << "Test polymorphic allocator" << endl;
+    using PmrVector = SimpleVector<string, pmr::polymorphic_allocator<string>>;
+    char buffer[4096];
+    pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), pmr::null_memory_resource());
+    const string long_str(100, 'x');
+
+    PmrVector v(&arena);
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(long_str);
+    }
+    v.Insert(v.begin() + 5, "middle"s);
+    assert(v.GetSize() == 11);
+    assert(v[5] == "middle"s);
+    assert(v.GetAllocator().resource() == &arena);
+
+    // копия получает ресурс по умолчанию, как у std::pmr::vector
+    PmrVector copy(v);
+    assert(copy == v);
+    assert(copy.GetAllocator().resource() == pmr::get_default_resource());
+
+    // при неравных ресурсах перемещение поэлементное, буфер остаётся на своём ресурсе
+    v = move(copy);
+    assert(v.GetSize() == 11);
+    assert(v.GetAllocator().resource() == &arena);
+    cout << "Done!" << endl << endl;
+}
+
+template <typename Vector>
+void CheckRelocation() {
+    Vector v;
+    for (int i = 0; i < 100; ++i) {
+        v.Insert(v.begin() + v.GetSize() / 2, i);
+    }
+    v.Insert(v.begin(), v[50]);
+    v.Erase(v.begin() + 1);
+    v.Reserve(1000);
+    v.EmplaceBack(v[0]);
+
+    SimpleVector<int> expected;
+    for (int i = 0; i < 100; ++i) {
+        expected.Insert(expected.begin() + expected.GetSize() / 2, i);
+    }
+    expected.Insert(expected.begin(), expected[50]);
+    expected.Erase(expected.begin() + 1);
+    expected.PushBack(expected[0]);
+    assert(v.GetSize() == expected.GetSize());
+    assert(equal(v.begin(), v.end(), expected.begin()));
+}
+
+struct Relocatable {
+    Relocatable(int value)
+        : value(make_unique<int>(value)) {
+    }
+    unique_ptr<int> value;
+};
+
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+void TestTriviallyRelocatable() {
+    cout << "Test trivially relocatable" << endl;
+    CheckRelocation<SimpleVector<int>>();
+    CheckRelocation<SimpleVector<int, MallocAllocator<int>>>();
+
+    SimpleVector<Relocatable> v;
+    for (int i = 0; i < 10; ++i) {
+        v.EmplaceBack(i);
+    }
+    v.Emplace(v.begin() + 3, 100);
+    v.Erase(v.begin());
+    assert(v.GetSize() == 10);
+    assert(*v[2].value == 100);
+    assert(*v[9].value == 9);
+    cout << "Done!" << endl << endl;
+}
+
+void TestGrowthPolicy() {
+    cout << "Test growth policy" << endl;
+    SimpleVector<int, allocator<int>, OneAndHalfGrowth> v;
+    v.Resize(10);
+    v.PushBack(1);
+    assert(v.GetCapacity() == 15);
+    v.Resize(16);
+    assert(v.GetCapacity() == 22);
+
+    SimpleVector<char, allocator<char>, SizeClassGrowth<>> bytes;
+    bytes.PushBack('a');
+    assert(bytes.GetCapacity() == 16);
+    bytes.Resize(17);
+    assert(bytes.GetCapacity() == 32);
+    bytes.Resize(100);
+    assert(bytes.GetCapacity() == 112);
+    bytes.Resize(5000);
+    assert(bytes.GetCapacity() == 8192);
+
+    SimpleVector<int, MallocAllocator<int>, InPlaceFirstGrowth<>> in_place(Reserve(1));
+    for (int i = 0; i < 100; ++i) {
+        in_place.PushBack(i);
+    }
+    assert(in_place.GetSize() == 100);
+    for (int i = 0; i < 100; ++i) {
+        assert(in_place[i] == i);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestSmallVector() {
+    cout << "Test small vector" << endl;
+    SmallSimpleVector<X, 4> v;
+    for (size_t i = 0; i < 3; ++i) {
+        v.PushBack(X(i));
+    }
+    assert(v.IsInline());
+    assert(v.GetCapacity() == 4);
+
+    SmallSimpleVector<X, 4> moved_inline(move(v));
+    assert(moved_inline.IsInline());
+    assert(moved_inline.GetSize() == 3 && v.GetSize() == 0);
+    assert(moved_inline[2].GetX() == 2);
+
+    moved_inline.EmplaceBack(3);
+    moved_inline.Insert(moved_inline.begin(), X(100));
+    assert(!moved_inline.IsInline());
+    assert(moved_inline.GetSize() == 5 && moved_inline.GetCapacity() == 8);
+    assert(moved_inline[0].GetX() == 100 && moved_inline[4].GetX() == 3);
+
+    SmallSimpleVector<X, 4> moved_heap;
+    moved_heap = move(moved_inline);
+    assert(!moved_heap.IsInline() && moved_inline.IsInline());
+    assert(moved_heap.GetSize() == 5 && moved_inline.GetSize() == 0);
+
+    moved_heap.Erase(moved_heap.begin());
+    assert(moved_heap[0].GetX() == 0);
+
+    SmallSimpleVector<string, 2> a{"a"s, "b"s};
+    SmallSimpleVector<string, 2> b{"a"s, "b"s, "c"s};
+    assert(a < b && a != b);
+    a.swap(b);
+    assert(a.GetSize() == 3 && b.GetSize() == 2 && b.IsInline());
+    b = a;
+    assert(a == b);
+    static_assert(noexcept(a.swap(b)));
+
+    // исключение при сдвиге во встроенном буфере не должно терять уже созданный последний элемент
+    {
+        SmallSimpleVector<ThrowingAssign, 8> throwing;
+        for (int i = 0; i < 4; ++i) {
+            throwing.EmplaceBack(i);
+        }
+        ThrowingAssign::assigns_left = 1;
+        try {
+            throwing.Emplace(throwing.begin() + 1, 10);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingAssign::assigns_left = numeric_limits<int>::max();
+        assert(throwing.GetSize() == 5);
+        assert(ThrowingAssign::alive == 5);
+    }
+    assert(ThrowingAssign::alive == 0);
+    cout << "Done!" << endl << endl;
+}
+
+// Перемещение может бросить исключение, поэтому при росте вектор должен копировать
+struct ThrowingMove {
+    ThrowingMove(int value)
+        : value(value) {
+    }
+    ThrowingMove(const ThrowingMove& other)
+        : value(other.value) {
+        if (copies_left-- == 0) {
+            throw runtime_error("copy failed");
+        }
+    }
+    ThrowingMove(ThrowingMove&& other) noexcept(false)
+        : value(exchange(other.value, -1)) {
+    }
+    ThrowingMove& operator=(const ThrowingMove&) = default;
+
+    int value;
+    static inline atomic<int> copies_left = 1'000'000;
+};
+
+void TestStrongGuarantee() {
+    cout << "Test strong exception guarantee" << endl;
+    static_assert(is_nothrow_move_constructible_v<SimpleVector<string>>);
+    static_assert(is_nothrow_move_assignable_v<SimpleVector<string>>);
+    static_assert(is_nothrow_move_constructible_v<ArrayPtr<string>>);
+    static_assert(!is_nothrow_move_assignable_v<SimpleVector<string, pmr::polymorphic_allocator<string>>>);
+
+    SimpleVector<ThrowingMove> v;
+    for (int i = 0; i < 4; ++i) {
+        v.EmplaceBack(i);
+    }
+    assert(v.GetSize() == v.GetCapacity());
+
+    ThrowingMove::copies_left = 2;
+    try {
+        v.EmplaceBack(4);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    try {
+        ThrowingMove::copies_left = 1;
+        v.Reserve(100);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    ThrowingMove::copies_left = 1'000'000;
+    assert(v.GetSize() == 4 && v.GetCapacity() == 4);
+    for (int i = 0; i < 4; ++i) {
+        assert(v[i].value == i);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+template <typename Type>
+void CheckRangeOperations(const vector<Type>& values) {
+    vector<Type> expected(values.begin(), values.begin() + 5);
+    SimpleVector<Type> v;
+    v.Assign(expected.begin(), expected.end());
+    assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+    // вставка в середину, хвост длиннее и короче вставляемого диапазона, с реаллокацией и без
+    for (size_t index : {4, 1, 6, 0}) {
+        expected.insert(expected.begin() + index, values.begin() + 5, values.end());
+        [[maybe_unused]] auto it = v.Insert(v.begin() + index, values.begin() + 5, values.end());
+        assert(it == v.begin() + index);
+        assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        v.Reserve(v.GetSize() * 3);
+    }
+
+    expected.insert(expected.begin() + 2, 3, expected[0]);
+    v.Insert(v.begin() + 2, 3, v[0]);
+    assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+    expected.erase(expected.begin() + 1, expected.begin() + 7);
+    [[maybe_unused]] auto it = v.Erase(v.begin() + 1, v.begin() + 7);
+    assert(it == v.begin() + 1);
+    assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+    v.Append(values.begin(), values.begin() + 2);
+    expected.insert(expected.end(), values.begin(), values.begin() + 2);
+    assert(equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+    [[maybe_unused]] const size_t capacity = v.GetCapacity();
+    v.Assign(values.begin(), values.begin() + 3);
+    assert(v.GetCapacity() == capacity);
+    assert(equal(v.begin(), v.end(), values.begin(), values.begin() + 3));
+}
+
+void TestRangeOperations() {
+    cout << "Test range operations" << endl;
+    CheckRangeOperations<int>({1, 2, 3, 4, 5, 6, 7, 8});
+    CheckRangeOperations<string>({"a"s, "b"s, "c"s, "d"s, "e"s, "f"s, "g"s, "h"s});
+
+    SimpleVector<int> v{1, 5};
+    istringstream input("2 3 4");
+    v.Insert(v.begin() + 1, istream_iterator<int>(input), istream_iterator<int>());
+    assert((v == SimpleVector<int>{1, 2, 3, 4, 5}));
+
+    SimpleVector<int> big(Reserve(2));
+    big.Assign(v.begin(), v.end());
+    assert(big == v && big.GetCapacity() == 5);
+    cout << "Done!" << endl << endl;
+}
+
+void TestDefaultInitResize() {
+    cout << "Test default-init resize" << endl;
+    SimpleVector<int> v{1, 2, 3};
+    v.ResizeDefaultInit(100);
+    assert(v.GetSize() == 100);
+    assert(v[0] == 1 && v[2] == 3);
+    fill(v.begin() + 3, v.end(), 7);
+    assert(v[99] == 7);
+
+    const string payload = "hello, world";
+    SimpleVector<char> buffer;
+    buffer.ResizeAndOverwrite(1024, [&payload](char* data, size_t size) {
+        assert(size == 1024);
+        return payload.copy(data, size);
+    });
+    assert(buffer.GetSize() == payload.size());
+    assert(string(buffer.begin(), buffer.end()) == payload);
+
+    SimpleVector<string> strings{"a"s};
+    strings.ResizeDefaultInit(3);
+    assert(strings[0] == "a"s && strings[2].empty());
+
+    // нетривиальные элементы создаются через аллокатор вектора
+    pmr::monotonic_buffer_resource arena;
+    SimpleVector<pmr::string, pmr::polymorphic_allocator<pmr::string>> pmr_strings(&arena);
+    pmr_strings.ResizeDefaultInit(2);
+    assert(pmr_strings[1].empty() && pmr_strings[1].get_allocator().resource() == &arena);
+    cout << "Done!" << endl << endl;
+}
+
+void TestShrinkToFit() {
+    cout << "Test shrink to fit" << endl;
+    SimpleVector<string> v(Reserve(100));
+    v.PushBack("a"s);
+    v.PushBack("b"s);
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 2);
+    assert((v == SimpleVector<string>{"a"s, "b"s}));
+
+    v.Clear();
+    v.ShrinkToFit();
+    assert(v.GetCapacity() == 0 && v.Data() == nullptr);
+
+    SimpleVector<int, MallocAllocator<int>, InPlaceFirstGrowth<>> ints(1000, 7);
+    ints.Resize(10);
+    ints.ShrinkToFit();
+    assert(ints.GetCapacity() == 10 && ints[9] == 7);
+    ints.ClearAndRelease();
+    assert(ints.IsEmpty() && ints.GetCapacity() == 0);
+    ints.PushBack(1);
+    assert(ints[0] == 1);
+    cout << "Done!" << endl << endl;
+}
+
+void TestParallelBulkOperations() {
+    cout << "Test parallel bulk operations" << endl;
+    ParallelExecution policy;
+    policy.threads = 4;
+    policy.min_size = 1000;
+
+    const size_t size = 100'000;
+    SimpleVector<int> filled(policy, size, 42);
+    assert(filled.GetSize() == size);
+    assert(all_of(filled.begin(), filled.end(), [](int x) { return x == 42; }));
+
+    SimpleVector<string> strings(100'003, "value"s);
+    SimpleVector<string> copy(policy, strings);
+    assert(copy == strings);
+    assert(Equal(policy, copy, strings) && !Less(policy, copy, strings));
+    copy[77'777] = "valuf"s;
+    assert(!Equal(policy, copy, strings));
+    assert(Less(policy, strings, copy) && !Less(policy, copy, strings));
+    copy.Resize(policy, 200'000);
+    assert(copy.GetSize() == 200'000 && copy[150'000].empty());
+    assert(Less(policy, copy, SimpleVector<string>(1, "w"s)));
+
+    // при исключении в одном куске все созданные элементы уничтожаются
+    try {
+        ThrowingMove::copies_left = 50'000;
+        SimpleVector<ThrowingMove> throwing(policy, size, ThrowingMove(1));
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    ThrowingMove::copies_left = 1'000'000;
+
+    // пустые диапазоны при min_size == 0 тоже идут параллельной веткой
+    ParallelExecution eager{4, 0};
+    SimpleVector<int> empty(eager, 0, 1);
+    assert(empty.IsEmpty());
+    SimpleVector<string> empty_strings(eager, SimpleVector<string>());
+    assert(empty_strings.IsEmpty());
+    empty.Resize(eager, 0);
+    assert(empty.IsEmpty());
+    empty_strings.Resize(eager, 0);
+    assert(empty_strings.IsEmpty());
+    [[maybe_unused]] const bool empty_equal = Equal(eager, empty, SimpleVector<int>());
+    [[maybe_unused]] const bool empty_less = Less(eager, empty, SimpleVector<int>());
+    assert(empty_equal && !empty_less);
+    [[maybe_unused]] const bool empty_before_strings = Less(eager, SimpleVector<string>(), strings);
+    assert(empty_before_strings);
+    empty.Resize(eager, 5000);
+    assert(empty.GetSize() == 5000 && empty[4999] == 0);
+
+    // границы кусков ложатся на страницы реального адреса, даже если массив начинается с середины страницы
+    {
+        SimpleVector<int> buffer(size + 1024);
+        const int* const base = buffer.Data() + 3;
+        mutex guard;
+        vector<size_t> begins;
+        size_t covered = 0;
+        ParallelFor(policy, size, parallel_detail::PageGrid(base), [&](size_t begin, size_t end) {
+            lock_guard lock(guard);
+            begins.push_back(begin);
+            covered += end - begin;
+        });
+        assert(covered == size && begins.size() > 1);
+        for ([[maybe_unused]] size_t begin : begins) {
+            assert(begin == 0 || reinterpret_cast<uintptr_t>(base + begin) % parallel_detail::kPageSize == 0);
+        }
+    }
+    cout << "Done!" << endl << endl;
+}
+
+template <typename Type>
+void CheckComparisons(Type small, Type big) {
+    for (size_t size : {0, 1, 3, 15, 16, 17, 31, 33, 64, 65, 130}) {
+        SimpleVector<Type> lhs(size, small);
+        for (size_t pos = 0; pos < size; pos += 7) {
+            SimpleVector<Type> rhs(lhs);
+            assert(lhs == rhs && !(lhs < rhs) && !(rhs < lhs));
+            rhs[pos] = big;
+            assert(lhs != rhs);
+            assert(lhs < rhs && !(rhs < lhs));
+            rhs.PopBack();
+            assert((lhs < rhs) == lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+        }
+    }
+}
+
+void TestSimdComparisons() {
+    cout << "Test SIMD comparisons" << endl;
+    CheckComparisons<uint8_t>(1, 200);
+    CheckComparisons<char>(-100, 100);
+    CheckComparisons<int>(-1, 1);
+    CheckComparisons<int64_t>(-1, INT64_MAX);
+    CheckComparisons<float>(-0.5f, 0.5f);
+    CheckComparisons<double>(-0.5, 0.5);
+
+    // как у std::equal и std::lexicographical_compare: 0.0 == -0.0, NaN не равен ничему,
+    // но и не меньше ничего
+    SimpleVector<float> zeros(20, 0.0f);
+    SimpleVector<float> negative_zeros(20, -0.0f);
+    assert(zeros == negative_zeros);
+    SimpleVector<double> nans(10, NAN);
+    SimpleVector<double> other_nans(nans);
+    assert(nans != other_nans);
+    assert(!(nans < other_nans) && !(other_nans < nans));
+    cout << "Done!" << endl << endl;
+}
+
+void TestMappedVector() {
+    cout << "Test mapped vector" << endl;
+    struct Record {
+        int id;
+        double value;
+    };
+    const string path = (filesystem::temp_directory_path() / "simple_vector_mapped_test.bin").string();
+    filesystem::remove(path);
+    const size_t size = 100000;
+    {
+        MappedSimpleVector<Record> records(path);
+        assert(records.IsEmpty() && records.GetCapacity() == 0);
+        for (size_t i = 0; i < size; ++i) {
+            records.PushBack({static_cast<int>(i), i * 0.5});
+        }
+        assert(records.GetSize() == size && records.GetCapacity() >= size);
+        records.PushBack(records[0]);
+        records.PopBack();
+        records.Sync();
+    }
+    // закрытый файл усечён до размера и открывается без копирования
+    assert(filesystem::file_size(path) == size * sizeof(Record));
+    {
+        MappedSimpleVector<Record> records(path);
+        records.Advise(MappedAdvice::kSequential);
+        records.Advise(MappedAdvice::kWillNeed);
+        assert(records.GetSize() == size);
+        for (size_t i = 0; i < size; ++i) {
+            assert(records[i].id == static_cast<int>(i) && records[i].value == i * 0.5);
+        }
+        records.Resize(10);
+        records.Resize(20);
+        assert(records[15].id == 0 && records.At(9).id == 9);
+        const Record extra[] = {{-1, 0}, {-2, 0}};
+        records.Append(extra, 2);
+        assert(records.GetSize() == 22 && records[21].id == -2);
+        MappedSimpleVector<Record> moved(std::move(records));
+        assert(moved.GetSize() == 22 && records.GetSize() == 0);
+    }
+    assert(filesystem::file_size(path) == 22 * sizeof(Record));
+    // Append из самого вектора при росте, который переносит отображение
+    {
+        MappedSimpleVector<Record> records(path);
+        const size_t capacity = records.GetCapacity();
+        while (records.GetCapacity() == capacity) {
+            records.Append(&records[0], records.GetSize());
+        }
+        assert(records.GetSize() % 22 == 0);
+        for (size_t i = 0; i < records.GetSize(); i += 7) {
+            assert(records[i].id == records[i % 22].id);
+        }
+        assert(records[21].id == -2 && records[records.GetSize() - 1].id == -2);
+    }
+    // только для чтения: изменения отвергаются, файл не усекается при закрытии
+    [[maybe_unused]] const uintmax_t bytes = filesystem::file_size(path);
+    {
+        MappedSimpleVector<Record> records(path, MappedMode::kReadOnly);
+        assert(records.IsReadOnly() && records.GetSize() * sizeof(Record) == bytes);
+        assert(as_const(records)[21].id == -2);
+        const Record extra{-3, 0};
+        for (const auto& mutate : {function<void()>([&] { records.PushBack(extra); }),
+                                   function<void()>([&] { records.Append(&extra, 1); }),
+                                   function<void()>([&] { records.Resize(1); }),
+                                   function<void()>([&] { records.Reserve(records.GetCapacity() + 1); })}) {
+            try {
+                mutate();
+                assert(false);
+            } catch (const logic_error&) {
+            }
+        }
+        MappedSimpleVector<Record> moved(std::move(records));
+        assert(moved.IsReadOnly());
+    }
+    assert(filesystem::file_size(path) == bytes);
+    try {
+        MappedSimpleVector<double> missing(path + ".missing", MappedMode::kReadOnly);
+        assert(false);
+    } catch (const system_error&) {
+    }
+    try {
+        MappedSimpleVector<double> doubles(path + ".missing/file");
+        assert(false);
+    } catch (const system_error&) {
+    }
+    filesystem::remove(path);
+    cout << "Done!" << endl << endl;
+}
+
+void TestSerialization() {
+    cout << "Test serialization" << endl;
+    SimpleVector<float> features(1000);
+    iota(features.begin(), features.end(), 0.5f);
+
+    ostringstream out;
+    Serialize(out, features);
+    const string bytes = out.str();
+    assert(bytes.size() == SerializedSize<float>(features.GetSize()));
+    istringstream in(bytes);
+    [[maybe_unused]] const SimpleVector<float> from_stream = Deserialize<float>(in);
+    assert(from_stream == features);
+
+    // чтение на месте из выровненного буфера
+    SimpleVector<char> buffer(bytes.size());
+    copy(bytes.begin(), bytes.end(), buffer.begin());
+    [[maybe_unused]] const SimpleVectorConstView<float> view = DeserializeView<float>(buffer.Data(), buffer.GetSize());
+    assert(view.begin() == reinterpret_cast<const float*>(buffer.Data() + sizeof(SerializedHeader)));
+    assert(view == features);
+
+    // через файловый дескриптор, несколько векторов подряд
+    const string path = (filesystem::temp_directory_path() / "simple_vector_serialize_test.bin").string();
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+    }
+    SimpleVector<double> empty;
+    int fd = ::open(path.c_str(), O_WRONLY);
+    Serialize(fd, features);
+    Serialize(fd, empty);
+    ::close(fd);
+    fd = ::open(path.c_str(), O_RDONLY);
+    [[maybe_unused]] const SimpleVector<float> from_fd = Deserialize<float>(fd);
+    assert(from_fd == features);
+    [[maybe_unused]] const SimpleVector<double> empty_from_fd = Deserialize<double>(fd);
+    assert(empty_from_fd.IsEmpty());
+    try {
+        Deserialize<int>(fd);
+        assert(false);
+    } catch (const invalid_argument&) {
+    }
+    ::close(fd);
+    filesystem::remove(path);
+
+    // другой тип элементов и обрезанные данные отвергаются
+    try {
+        DeserializeView<double>(buffer.Data(), buffer.GetSize());
+        assert(false);
+    } catch (const invalid_argument&) {
+    }
+    try {
+        DeserializeView<float>(buffer.Data(), buffer.GetSize() - 1);
+        assert(false);
+    } catch (const invalid_argument&) {
+    }
+
+    // испорченный счётчик элементов не приводит к огромному выделению памяти
+    for (uint64_t count : {uint64_t{1001}, uint64_t{1} << 40, UINT64_MAX}) {
+        string corrupted = bytes;
+        memcpy(corrupted.data() + offsetof(SerializedHeader, count), &count, sizeof(count));
+        istringstream corrupted_in(corrupted);
+        try {
+            Deserialize<float>(corrupted_in);
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+        {
+            ofstream file(path, ios::binary | ios::trunc);
+            file << corrupted;
+        }
+        fd = ::open(path.c_str(), O_RDONLY);
+        try {
+            Deserialize<float>(fd);
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+        ::close(fd);
+    }
+    filesystem::remove(path);
+    cout << "Done!" << endl << endl;
+}
+
+// Представление принимается вместо вектора без копирования
+int64_t SumOf(SimpleVectorConstView<int> numbers) {
+    return accumulate(numbers.begin(), numbers.end(), int64_t{0});
+}
+
+void Negate(SimpleVectorView<int> numbers) {
+    for (int& number : numbers) {
+        number = -number;
+    }
+}
+
+void TestViews() {
+    cout << "Test views" << endl;
+    SimpleVector<int> numbers(10);
+    iota(numbers.begin(), numbers.end(), 0);
+    assert(SumOf(numbers) == 45);
+
+    SimpleVectorView<int> all = numbers;
+    assert(all.GetSize() == 10 && all.begin() == numbers.Data());
+    assert(all.First(3) == (SimpleVector<int>{0, 1, 2}));
+    assert(all.Last(2) == (SimpleVector<int>{8, 9}));
+    assert(all.Subview(4, 3) == (SimpleVector<int>{4, 5, 6}));
+    assert(all.Subview(8).GetSize() == 2 && all.Subview(10).IsEmpty());
+    try {
+        all.Subview(11);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+    try {
+        all.At(10);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    Negate(all.Subview(0, 5));
+    assert(numbers[4] == -4 && numbers[5] == 5);
+    assert(SumOf(all.First(5)) == -10);
+
+    // сравнения между представлениями, константными представлениями и векторами
+    const SimpleVector<int>& const_numbers = numbers;
+    SimpleVectorView tail(const_numbers);
+    static_assert(is_same_v<decltype(tail), SimpleVectorConstView<int>>);
+    assert(tail == numbers && numbers == tail && all == tail);
+    assert(tail.First(2) < tail.First(3) && all.Last(1) > all.First(1));
+    assert(all.First(0) == SimpleVectorConstView<int>());
+
+    SmallSimpleVector<int, 4> small{1, 2};
+    assert(SumOf(small) == 3);
+
+    SimpleVector<int> copy;
+    copy.Append(all.Last(3).begin(), all.Last(3).end());
+    assert(copy == all.Last(3));
+    assert(Equal<int>(ParallelExecution{}, all.First(5), copy) == false);
+    assert(Less<int>(ParallelExecution{2, 1}, all.First(5), copy));
+
+    ostringstream out;
+    Serialize(out, all.Subview(2, 4));
+    istringstream in(out.str());
+    [[maybe_unused]] const SimpleVector<int> deserialized = Deserialize<int>(in);
+    assert(all.Subview(2, 4) == deserialized);
+    cout << "Done!" << endl << endl;
+}
+
+void TestAdoptAndRelease() {
+    cout << "Test adopt and release" << endl;
+    // производитель строит буфер, потребитель забирает его без копирования
+    SimpleVector<string> produced;
+    produced.Reserve(8);
+    for (int i = 0; i < 5; ++i) {
+        produced.PushBack(to_string(i));
+    }
+    [[maybe_unused]] const string* data = produced.Data();
+    ReleasedBuffer<string> buffer = produced.ReleaseBuffer();
+    assert(produced.IsEmpty() && produced.GetCapacity() == 0 && produced.Data() == nullptr);
+    assert(buffer.data == data && buffer.size == 5 && buffer.capacity == 8);
+
+    SimpleVector<string> consumed{"old"};
+    consumed.Adopt(buffer.data, buffer.size, buffer.capacity);
+    assert(consumed.Data() == data && consumed.GetSize() == 5 && consumed.GetCapacity() == 8);
+    assert(consumed[4] == "4");
+    consumed.PushBack("5");
+    assert(consumed.Data() == data);
+
+    // буфер ArrayPtr с частью сконструированных элементов
+    ArrayPtr<Counted> items(4);
+    new (items.Get()) Counted();
+    new (items.Get() + 1) Counted();
+    [[maybe_unused]] const int alive = Counted::alive;
+    {
+        SimpleVector<Counted> counted;
+        counted.Adopt(std::move(items), 2);
+        assert(!items && counted.GetSize() == 2 && counted.GetCapacity() == 4);
+    }
+    assert(Counted::alive == alive - 2);
+
+    // обмен с C API через malloc/free
+    SimpleVector<int, MallocAllocator<int>> numbers;
+    int* raw = static_cast<int*>(malloc(3 * sizeof(int)));
+    raw[0] = 1;
+    raw[1] = 2;
+    numbers.Adopt(raw, 2, 3);
+    numbers.PushBack(3);
+    assert((numbers == SimpleVector<int, MallocAllocator<int>>{1, 2, 3}));
+    ReleasedBuffer<int> released = numbers.ReleaseBuffer();
+    assert(released.size == 3 && released.data[2] == 3);
+    free(released.data);
+    cout << "Done!" << endl << endl;
+}
+
+void TestConcurrentVector() {
+    cout << "Test concurrent vector" << endl;
+    constexpr size_t kWriters = 8;
+    constexpr size_t kPerWriter = 20000;
+    ConcurrentSimpleVector<size_t> values;
+    values.PushBack(0);
+    [[maybe_unused]] const size_t* first = &values[0];
+
+    atomic<bool> done{false};
+    thread reader([&] {
+        [[maybe_unused]] size_t last_size = 0;
+        while (!done.load()) {
+            const size_t size = values.GetSize();
+            assert(size >= last_size);
+            last_size = size;
+            size_t seen = 0;
+            for ([[maybe_unused]] size_t value : values) {
+                assert(value <= kWriters * kPerWriter);
+                ++seen;
+            }
+            assert(seen >= size);
+        }
+    });
+    vector<thread> writers;
+    for (size_t w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&values, w] {
+            for (size_t i = 1; i <= kPerWriter; ++i) {
+                [[maybe_unused]] const size_t index = values.PushBack(w * kPerWriter + i);
+                assert(values[index] == w * kPerWriter + i);
+            }
+        });
+    }
+    for (thread& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    reader.join();
+
+    // элементы не переезжают, и каждое значение добавлено ровно один раз
+    assert(&values[0] == first);
+    assert(values.GetSize() == kWriters * kPerWriter + 1);
+    vector<size_t> sorted(values.begin(), values.end());
+    sort(sorted.begin(), sorted.end());
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        assert(sorted[i] == i);
+    }
+
+    // элемент, конструктор которого бросил исключение, обход пропускает
+    {
+        ConcurrentSimpleVector<ThrowingMove> throwing;
+        ThrowingMove::copies_left = 1;
+        const ThrowingMove item(7);
+        throwing.PushBack(item);
+        try {
+            throwing.PushBack(item);
+            assert(false);
+        } catch (const runtime_error&) {
+        }
+        ThrowingMove::copies_left = 1'000'000;
+        [[maybe_unused]] const ThrowingMove& emplaced = throwing.EmplaceBack(8);
+        assert(emplaced.value == 8);
+        assert(throwing.GetSize() == 3);
+        assert(distance(throwing.begin(), throwing.end()) == 2);
+        assert(throwing.begin()->value == 7 && next(throwing.begin())->value == 8);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+// Считает выделения памяти, передавая их ресурсу по умолчанию
+struct CountingResource : pmr::memory_resource {
+    size_t allocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+void TestSegmentedVector() {
+    cout << "Test segmented vector" << endl;
+    static_assert(DefaultChunkSize<int>() == 16384 && DefaultChunkSize<char[100000]>() == 1);
+
+    // маленькие куски, чтобы рост пересекал много границ
+    SegmentedSimpleVector<string, allocator<string>, 4> strings;
+    strings.PushBack("first");
+    [[maybe_unused]] const string* first = &strings[0];
+    for (int i = 1; i < 100; ++i) {
+        strings.EmplaceBack(to_string(i));
+    }
+    assert(&strings[0] == first && strings.GetSize() == 100 && strings.GetCapacity() == 100);
+    assert(strings[57] == "57" && strings.At(99) == "99");
+    try {
+        strings.At(100);
+        assert(false);
+    } catch (const out_of_range&) {
+    }
+
+    // итераторы произвольного доступа для алгоритмов
+    auto it = strings.begin() + 10;
+    assert(*it == "10" && it[5] == "15" && strings.end() - it == 90);
+    assert(find(strings.begin(), strings.end(), "42") - strings.begin() == 42);
+    [[maybe_unused]] SegmentedSimpleVector<string, allocator<string>, 4>::ConstIterator const_it = it;
+    assert(const_it->size() == 2);
+    SegmentedSimpleVector<int, allocator<int>, 8> numbers{5, 3, 9, 1, 7, 2, 8, 6, 4, 0};
+    sort(numbers.begin(), numbers.end());
+    for (int i = 0; i < 10; ++i) {
+        assert(numbers[i] == i);
+    }
+    // итератор переживает рост, перевыделяющий таблицу кусков
+    [[maybe_unused]] const auto third = numbers.cbegin() + 3;
+    for (int i = 10; i < 1000; ++i) {
+        numbers.PushBack(i);
+    }
+    assert(*third == 3 && third[996] == 999 && numbers.end() - third == 997);
+
+    auto copy = strings;
+    assert(copy == strings && !(copy < strings));
+    copy.PopBack();
+    assert(copy < strings && copy != strings);
+    auto moved = std::move(copy);
+    assert(moved.GetSize() == 99 && copy.IsEmpty());
+
+    strings.Resize(5);
+    assert(strings.GetSize() == 5 && strings.GetCapacity() == 100);
+    strings.ShrinkToFit();
+    assert(strings.GetCapacity() == 8 && &strings[0] == first);
+    strings.Resize(10);
+    assert(strings[9].empty());
+    strings.Clear();
+    assert(strings.IsEmpty() && strings.GetCapacity() == 12);
+
+    // неравные pmr-аллокаторы: перемещение поэлементное
+    pmr::monotonic_buffer_resource resource;
+    SegmentedSimpleVector<int, pmr::polymorphic_allocator<int>, 4> pmr_numbers(10, 7, &resource);
+    SegmentedSimpleVector<int, pmr::polymorphic_allocator<int>, 4> other;
+    other = std::move(pmr_numbers);
+    assert(other.GetSize() == 10 && other[9] == 7);
+
+    // при росте по одному элементу таблица кусков перевыделяется O(log n) раз
+    CountingResource counting;
+    {
+        SegmentedSimpleVector<int, pmr::polymorphic_allocator<int>, 1> singles(&counting);
+        for (int i = 0; i < 1000; ++i) {
+            singles.PushBack(i);
+        }
+        assert(singles.GetSize() == 1000 && singles[999] == 999);
+    }
+    assert(counting.allocations < 1000 + 20);
+    cout << "Done!" << endl << endl;
+}
+
+// Копируемый тип с нетривиальными копированием и деструктором, который можно переносить побайтово
+struct SharedValue {
+    shared_ptr<int> value;
+};
+
+bool operator==(const SharedValue& lhs, const SharedValue& rhs) {
+    return *lhs.value == *rhs.value;
+}
+
+template <>
+struct IsTriviallyRelocatable<SharedValue> : std::true_type {};
+
+template <typename Type>
+void CheckFastErase(Type (*make)(int)) {
+    SimpleVector<Type> v;
+    for (int i = 0; i < 20; ++i) {
+        v.PushBack(make(i));
+    }
+    // порядок после UnorderedErase не сохраняется, но набор элементов верный
+    [[maybe_unused]] auto it = v.UnorderedErase(v.begin() + 3);
+    assert(*it == make(19) && v.GetSize() == 19);
+    v.UnorderedErase(v.end() - 1);
+    assert(v.GetSize() == 18 && v[17] == make(17));
+
+    [[maybe_unused]] const size_t removed = v.EraseIf([&make](const Type& item) {
+        return item == make(0) || item == make(5) || item == make(6) || item == make(17);
+    });
+    assert(removed == 4);
+    assert((v == SimpleVector<Type>{make(1), make(2), make(19), make(4), make(7), make(8), make(9),
+                                    make(10), make(11), make(12), make(13), make(14), make(15), make(16)}));
+    [[maybe_unused]] const size_t removed_none = v.EraseIf([](const Type&) { return false; });
+    assert(removed_none == 0);
+
+    v.PushBack(make(4));
+    [[maybe_unused]] const size_t removed_fours = v.Remove(make(4));
+    assert(removed_fours == 2 && v.GetSize() == 13);
+    // значение из самого вектора
+    [[maybe_unused]] const size_t removed_first = v.Remove(v[0]);
+    assert(removed_first == 1 && v[0] == make(2));
+
+    const size_t indices[] = {0, 3, 4, 11};
+    v.EraseIndices({indices, 4});
+    assert((v == SimpleVector<Type>{make(19), make(7), make(10), make(11), make(12), make(13),
+                                    make(14), make(15)}));
+    v.EraseIndices({});
+    assert(v.GetSize() == 8);
+}
+
+void TestFastErase() {
+    cout << "Test fast erase" << endl;
+    CheckFastErase<int>([](int i) {
+        return i;
+    });
+    CheckFastErase<string>([](int i) {
+        return string(20, 'a') + to_string(i);
+    });
+    CheckFastErase<SharedValue>([](int i) {
+        return SharedValue{make_shared<int>(i)};
+    });
+
+    // исключение из предиката оставляет вектор целым
+    SimpleVector<int> numbers{1, 2, 3, 4, 5, 6};
+    try {
+        numbers.EraseIf([](int n) {
+            if (n == 5) {
+                throw runtime_error("predicate failed");
+            }
+            return n % 2 == 0;
+        });
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    assert((numbers == SimpleVector<int>{1, 3, 5, 6}));
+    cout << "Done!" << endl << endl;
+}
+
+void TestSoAVector() {
+    cout << "Test structure-of-arrays vector" << endl;
+    using Particles = SoASimpleVector<float, double, string>;
+    Particles particles;
+    assert(particles.IsEmpty() && particles.GetCapacity() == 0);
+    for (int i = 0; i < 100; ++i) {
+        particles.PushBack({static_cast<float>(i), i * 0.5, to_string(i)});
+    }
+    assert(particles.GetSize() == 100 && particles.GetCapacity() >= 100);
+
+    // столбцы непрерывны, выровнены и растут вместе
+    [[maybe_unused]] const auto check_aligned = [](const void* p) {
+        return reinterpret_cast<uintptr_t>(p) % Particles::kColumnAlignment == 0;
+    };
+    assert(check_aligned(particles.Column<0>().begin()));
+    assert(check_aligned(particles.Column<1>().begin()));
+    assert(check_aligned(particles.Column<2>().begin()));
+    [[maybe_unused]] const auto xs = particles.Column<0>();
+    assert(xs.GetSize() == 100 && accumulate(xs.begin(), xs.end(), 0.0f) == 4950.0f);
+    assert(get<2>(particles[42]) == "42");
+
+    for (float& x : particles.Column<0>()) {
+        x *= 2;
+    }
+    auto [x, speed, name] = particles.At(10);
+    assert(x == 20.0f && speed == 5.0 && name == "10");
+    name = "ten";
+    assert(particles.Column<2>()[10] == "ten");
+
+    // аргументы EmplaceBack могут ссылаться на записи самого вектора
+    particles.Resize(particles.GetCapacity());
+    [[maybe_unused]] const size_t capacity = particles.GetCapacity();
+    [[maybe_unused]] auto added = particles.EmplaceBack(get<0>(particles[1]), get<1>(particles[1]), get<2>(particles[1]));
+    assert(particles.GetCapacity() > capacity);
+    assert(get<2>(added) == "1" && get<0>(added) == 2.0f);
+    assert(particles.Column<1>().GetSize() == particles.GetSize());
+    particles.PopBack();
+
+    Particles copy = particles;
+    assert(copy == particles);
+    get<1>(copy[0]) = -1;
+    assert(copy != particles);
+    copy.Clear();
+    assert(copy.IsEmpty() && copy.GetCapacity() >= particles.GetSize());
+    copy.swap(particles);
+    assert(particles.IsEmpty() && copy.GetSize() > 100);
+
+    // исключение в конструкторе поля не рассинхронизирует столбцы
+    SoASimpleVector<int, ThrowingMove> records;
+    records.Reserve(4);
+    records.PushBack({1, ThrowingMove(1)});
+    const tuple<int, ThrowingMove> record{2, ThrowingMove(2)};
+    ThrowingMove::copies_left = 0;
+    try {
+        records.PushBack(record);
+        assert(false);
+    } catch (const runtime_error&) {
+    }
+    ThrowingMove::copies_left = 1'000'000;
+    assert(records.GetSize() == 1 && records.Column<0>().GetSize() == 1);
+    assert(get<1>(records[0]).value == 1);
+    cout << "Done!" << endl << endl;
+}
+
+void TestAlignedAllocator() {
+    cout << "Test aligned and huge page allocation" << endl;
+    [[maybe_unused]] const auto aligned_to = [](const void* p, size_t alignment) {
+        return reinterpret_cast<uintptr_t>(p) % alignment == 0;
+    };
+    SimpleVector<char, AlignedAllocator<char, 32>> bytes(3);
+    assert(aligned_to(bytes.Data(), 32));
+
+    // блок округлён до 64 байт, и вектор растёт в этот хвост без переноса
+    SimpleVector<int, AlignedAllocator<int>, InPlaceFirstGrowth<>> ints;
+    ints.PushBack(1);
+    [[maybe_unused]] const int* first = ints.Data();
+    assert(aligned_to(first, 64));
+    for (int i = 2; i <= 16; ++i) {
+        ints.PushBack(i);
+    }
+    assert(ints.Data() == first && ints.GetCapacity() == 16);
+    ints.PushBack(17);
+    assert(ints.Data() != first && aligned_to(ints.Data(), 64));
+
+    // большие блоки выровнены по большой странице, малые — по строке кэша
+    SimpleVector<double, HugePageAllocator<double>> small(10);
+    assert(aligned_to(small.Data(), 64));
+    SimpleVector<double, HugePageAllocator<double>> large(
+            HugePageAllocator<double>::kHugePageSize / sizeof(double) + 1, 1.0);
+    assert(aligned_to(large.Data(), HugePageAllocator<double>::kHugePageSize));
+    assert(accumulate(large.begin(), large.end(), 0.0) == static_cast<double>(large.GetSize()));
+    cout << "Done!" << endl << endl;
+}
+
+void TestArenaAllocator() {
+    cout << "Test arena allocator" << endl;
+    SimpleVectorArena arena;
+
+    // последний блок арены растёт на месте, без переноса элементов
+    ArenaSimpleVector<int> ints(&arena);
+    ints.PushBack(0);
+    [[maybe_unused]] const int* first = ints.Data();
+    for (int i = 1; i < 8000; ++i) {
+        ints.PushBack(i);
+    }
+    assert(ints.Data() == first && ints.GetCapacity() == 8192);
+    assert(ints[7999] == 7999);
+
+    // после чужого выделения блок переносится; копия остаётся в той же арене
+    ArenaSimpleVector<string> names(&arena);
+    names.PushBack(string(100, 'a'));
+    names.PushBack(string(100, 'b'));
+    ints.Resize(20000);
+    assert(ints.Data() != first && ints[7999] == 7999 && ints[19999] == 0);
+    ArenaSimpleVector<string> copy(names);
+    assert(copy == names && copy.GetAllocator() == names.GetAllocator());
+
+    // блоки больше куска получают отдельный кусок
+    ArenaSimpleVector<char> big(&arena);
+    big.Resize(SimpleVectorArena::kDefaultChunkSize * 3);
+    fill(big.begin(), big.end(), 'x');
+    assert(big[big.GetSize() - 1] == 'x');
+
+    // освобождённый последним блок возвращается арене
+    void* a = arena.Allocate(16, 8);
+    arena.Deallocate(a, 16);
+    [[maybe_unused]] void* reused = arena.Allocate(16, 8);
+    assert(reused == a);
+
+    // сначала заполняется буфер вызывающего; Reset возвращает всю память разом
+    alignas(16) char buffer[256];
+    SimpleVectorArena local(buffer, sizeof(buffer));
+    {
+        ArenaSimpleVector<double> values(&local);
+        values.Reserve(8);
+        assert(static_cast<void*>(values.Data()) == buffer);
+        values.Resize(100);
+        values[99] = 1.5;
+        assert(values[99] == 1.5 && values[0] == 0.0);
+    }
+    local.Reset();
+    {
+        ArenaSimpleVector<double> values(&local);
+        values.PushBack(2.5);
+        assert(values[0] == 2.5);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+void TestCowVector() {
+    cout << "Test copy-on-write vector" << endl;
+    CowSimpleVector<string> snapshot{"a", "b", "c"};
+    assert(!snapshot.IsShared());
+
+    // копия делит буфер, пока её не изменят
+    CowSimpleVector<string> copy = snapshot;
+    assert(copy.IsShared() && copy.Get().Data() == snapshot.Get().Data());
+    [[maybe_unused]] const CowSimpleVector<string>& const_copy = copy;
+    assert(const_copy[1] == "b" && copy.Get().Data() == snapshot.Get().Data());
+    copy[1] = "B";
+    assert(!copy.IsShared() && !snapshot.IsShared());
+    assert(copy.Get().Data() != snapshot.Get().Data());
+    assert(snapshot[1] == "b" && copy[1] == "B" && copy != snapshot);
+
+    // вставка и удаление по итератору в общий буфер
+    copy = snapshot;
+    copy.Insert(copy.begin() + 1, "x");
+    assert((copy.Get() == SimpleVector<string>{"a", "x", "b", "c"}));
+    copy = snapshot;
+    copy.Erase(copy.begin());
+    assert((copy.Get() == SimpleVector<string>{"b", "c"}));
+    copy = snapshot;
+    copy.PushBack(copy[0]);
+    assert(copy.GetSize() == 4 && copy[3] == "a" && snapshot.GetSize() == 3);
+
+    // очистка общей копии не клонирует буфер
+    copy = snapshot;
+    copy.Clear();
+    assert(copy.IsEmpty() && snapshot.GetSize() == 3 && !snapshot.IsShared());
+    copy.Resize(2);
+    assert(copy.GetSize() == 2 && copy[0].empty());
+
+    // изменяемая ссылка, полученная до копирования, не меняет копию
+    CowSimpleVector<int> numbers{1, 2, 3};
+    int& first = numbers[0];
+    const CowSimpleVector<int> numbers_copy = numbers;
+    assert(!numbers.IsShared() && numbers_copy.Get().Data() != numbers.Get().Data());
+    first = 5;
+    assert(numbers_copy[0] == 1 && numbers[0] == 5);
+    // без выданных ссылок копия снова делит буфер
+    CowSimpleVector<int> shared_copy = numbers_copy;
+    assert(shared_copy.IsShared() && shared_copy.Get().Data() == numbers_copy.Get().Data());
+    shared_copy.PushBack(4);
+    CowSimpleVector<int> after_push = shared_copy;
+    assert(after_push.IsShared());
+    // следующее изменение снимает пометку, и копия снова стоит одного счётчика
+    numbers.PushBack(4);
+    const CowSimpleVector<int> numbers_shared = numbers;
+    assert(numbers_shared.IsShared() && numbers_shared.Get().Data() == numbers.Get().Data());
+    CowSimpleVector<string> built;
+    for (int i = 0; i < 10; ++i) {
+        built.EmplaceBack(to_string(i));
+    }
+    built.Erase(built.begin());
+    built.Insert(built.begin(), "0");
+    const CowSimpleVector<string> built_copy = built;
+    assert(built_copy.IsShared() && built.IsShared());
+
+    // раздача снимка потокам копирует только указатель
+    CowSimpleVector<int> config(SimpleVector<int>(100000, 1));
+    atomic<long long> total = 0;
+    vector<thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&config, &total, t] {
+            CowSimpleVector<int> local = config;
+            assert(local.Get().Data() == config.Get().Data());
+            if (t == 0) {
+                local.Mutable()[0] = 2;
+            }
+            total += accumulate(local.begin(), local.end(), 0LL);
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    assert(total == 8 * 100000 + 1 && config[0] == 1 && !config.IsShared());
+    cout << "Done!" << endl << endl;
+}
+
+#if defined(__cpp_lib_constexpr_dynamic_alloc)
+// Таблица строится через SimpleVector при компиляции и переносится в StaticSimpleVector,
+// который попадает в исполняемый файл готовым
+constexpr StaticSimpleVector<int, 16> MakeSquares() {
+    SimpleVector<int> squares;
+    for (int i = 9; i >= 0; --i) {
+        squares.Insert(squares.begin(), i * i);
+    }
+    squares.PushBack(-1);
+    squares.Erase(squares.end() - 1);
+    StaticSimpleVector<int, 16> table;
+    for (int square : squares) {
+        table.PushBack(square);
+    }
+    return table;
+}
+
+constexpr StaticSimpleVector<int, 16> kSquares = MakeSquares();
+static_assert(kSquares.GetSize() == 10 && kSquares[3] == 9 && kSquares[9] == 81);
+
+constexpr bool CheckConstexprSimpleVector() {
+    SimpleVector<int> v{5, 1, 4};
+    v.Reserve(10);
+    v.Resize(5);
+    v.EraseIf([](int x) {
+        return x == 0;
+    });
+    SimpleVector<int> copy = v;
+    copy.Insert(copy.begin() + 1, 3, 7);
+    SimpleVector<string> words;
+    words.EmplaceBack("constexpr");
+    words.Insert(words.begin(), "compile-time");
+    return v == SimpleVector<int>{5, 1, 4} && v < copy && copy.GetSize() == 6 && copy[3] == 7
+           && words[1] == "constexpr";
+}
+
+static_assert(CheckConstexprSimpleVector());
+#endif
+
+void TestStaticVector() {
+    cout << "Test static vector" << endl;
+    StaticSimpleVector<string, 4> v{"b", "d"};
+    static_assert(sizeof(v) < 4 * sizeof(string) + 2 * sizeof(size_t));
+    v.Insert(v.begin(), "a");
+    v.Insert(v.begin() + 2, v[0]);
+    assert((v == StaticSimpleVector<string, 4>{"a", "b", "a", "d"}));
+    try {
+        v.PushBack("e");
+        assert(false);
+    } catch (const length_error&) {
+    }
+    assert(v.GetSize() == 4 && v[3] == "d");
+    v.Erase(v.begin() + 1, v.begin() + 3);
+    assert((v == StaticSimpleVector<string, 4>{"a", "d"}));
+
+    StaticSimpleVector<string, 4> other(3, "x");
+    v.swap(other);
+    assert(v.GetSize() == 3 && other.GetSize() == 2 && other[1] == "d");
+    other = v;
+    assert(other == v);
+    v.Resize(1);
+    v.PopBack();
+    assert(v.IsEmpty());
+
+    // тривиальные элементы: вектор тривиально копируется
+    static_assert(is_trivially_copyable_v<StaticSimpleVector<int, 8>>);
+    StaticSimpleVector<int, 8> ints(8);
+    assert(ints.GetSize() == 8 && ints[7] == 0);
+    try {
+        ints.Resize(9);
+        assert(false);
+    } catch (const length_error&) {
+    }
+#if defined(__cpp_lib_constexpr_dynamic_alloc)
+    assert(accumulate(kSquares.begin(), kSquares.end(), 0) == 285);
+#endif
+    cout << "Done!" << endl << endl;
+}
+
+template <typename Type, typename Compare = less<>>
+void CheckParallelSort(const ParallelExecution& policy, SimpleVector<Type> values, Compare comp = {}) {
+    vector<Type> expected(values.begin(), values.end());
+    sort(expected.begin(), expected.end(), comp);
+    Sort(policy, values, comp);
+    assert(equal(values.begin(), values.end(), expected.begin(), expected.end()));
+}
+
+void TestParallelAlgorithms() {
+    cout << "Test parallel algorithms" << endl;
+    mt19937_64 random(42);
+    for (size_t threads : {1, 3, 4, 7}) {
+        ParallelExecution policy;
+        policy.threads = threads;
+        policy.min_size = 1000;
+
+        // поразрядная сортировка: беззнаковые, знаковые и узкие ключи
+        SimpleVector<uint64_t> keys(60'003);
+        generate(keys.begin(), keys.end(), ref(random));
+        CheckParallelSort(policy, keys);
+        SimpleVector<int64_t> signed_keys(40'001);
+        generate(signed_keys.begin(), signed_keys.end(), [&random] {
+            return static_cast<int64_t>(random() % 2001) - 1000;
+        });
+        CheckParallelSort(policy, signed_keys);
+        SimpleVector<int8_t> bytes(5000);
+        generate(bytes.begin(), bytes.end(), [&random] {
+            return static_cast<int8_t>(random());
+        });
+        CheckParallelSort(policy, bytes);
+
+        // сортировка слиянием: другой порядок и нецелые элементы
+        CheckParallelSort(policy, signed_keys, greater<>());
+        SimpleVector<string> words(10'001);
+        generate(words.begin(), words.end(), [&random] {
+            return to_string(random() % 100'000);
+        });
+        CheckParallelSort(policy, words);
+        CheckParallelSort(policy, SimpleVector<double>{3.5, -1.0, 2.0});
+    }
+
+    ParallelExecution policy;
+    policy.threads = 4;
+    policy.min_size = 1000;
+    SimpleVector<int> numbers(100'000);
+    iota(numbers.begin(), numbers.end(), 0);
+
+    // сортировка части вектора через представление
+    SimpleVectorView<int> tail = SimpleVectorView(numbers).Subview(50'000);
+    reverse(tail.begin(), tail.end());
+    Sort(policy, tail);
+    assert(is_sorted(numbers.begin(), numbers.end()));
+
+    SimpleVector<int64_t> squares(numbers.GetSize());
+    Transform(policy, numbers, squares, [](int x) {
+        return int64_t{x} * x;
+    });
+    assert(squares[99'999] == int64_t{99'999} * 99'999);
+    assert(Reduce(policy, numbers, int64_t{0}) == int64_t{99'999} * 100'000 / 2);
+    assert(Reduce(policy, SimpleVector<int>{1, 2, 3, 4}, 10, multiplies<>()) == 240);
+    assert(Reduce(policy, squares, int64_t{0}, [](int64_t a, int64_t b) {
+               return max(a, b);
+           }) == squares[99'999]);
+
+    assert(Find(policy, numbers, 76'543) == numbers.Data() + 76'543);
+    assert(Find(policy, numbers, -1) == numbers.Data() + numbers.GetSize());
+    assert(FindIf(policy, squares, [](int64_t x) {
+               return x > 1'000'000;
+           }) == squares.Data() + 1001);
+
+    // LowerBound совпадает с std::lower_bound на всех позициях
+    for (size_t size : {0, 1, 2, 3, 7, 8, 100, 1025}) {
+        SimpleVector<int> sorted(size);
+        for (size_t i = 0; i < size; ++i) {
+            sorted[i] = static_cast<int>(i / 2 * 2);
+        }
+        const SimpleVectorConstView<int> view(sorted);
+        for (int value = -1; value <= static_cast<int>(size) + 1; ++value) {
+            assert(LowerBound(sorted, value) == lower_bound(view.begin(), view.end(), value));
+        }
+    }
+    const SimpleVector<int> descending{9, 7, 7, 3};
+    assert(LowerBound(descending, 7, greater<>()) == descending.Data() + 1);
+
+    // пустые диапазоны при min_size == 0 проходят через параллельные ветки
+    ParallelExecution eager{4, 0};
+    SimpleVector<int> no_ints;
+    SimpleVector<string> no_strings;
+    Sort(eager, no_ints);
+    Sort(eager, no_ints, greater<>());
+    Sort(eager, no_strings);
+    assert(no_ints.IsEmpty() && no_strings.IsEmpty());
+    SimpleVector<int64_t> no_squares;
+    Transform(eager, no_ints, no_squares, [](int x) {
+        return int64_t{x} * x;
+    });
+    [[maybe_unused]] const int64_t empty_sum = Reduce(eager, no_ints, int64_t{5});
+    assert(empty_sum == 5);
+    [[maybe_unused]] const int* not_found = Find(eager, no_ints, 1);
+    assert(not_found == no_ints.Data());
+    [[maybe_unused]] const string* no_word = FindIf(eager, no_strings, [](const string& word) {
+        return word.empty();
+    });
+    assert(no_word == no_strings.Data());
+    SimpleVector<int> one{7};
+    Sort(eager, one);
+    assert(one[0] == 7);
+    cout << "Done!" << endl << endl;
+}
+
+void TestStreamingAppend() {
+    cout << "Test streaming append" << endl;
+    SimpleVector<uint32_t> values(100000);
+    iota(values.begin(), values.end(), 7u);
+    const string bytes(reinterpret_cast<const char*>(values.Data()), values.GetSize() * sizeof(uint32_t));
+
+    // верная оценка: один буфер, без роста и лишнего чтения
+    {
+        SimpleVector<uint32_t> v{1, 2};
+        istringstream in(bytes);
+        [[maybe_unused]] const size_t appended = AppendFromStream(v, in, values.GetSize());
+        assert(appended == values.GetSize());
+        assert(v.GetSize() == values.GetSize() + 2 && v.GetCapacity() == v.GetSize());
+        assert(equal(values.begin(), values.end(), v.begin() + 2));
+        assert(in.eof() && !in.fail());
+    }
+    // без оценки вектор растёт по своей политике
+    {
+        SimpleVector<uint32_t> v;
+        istringstream in(bytes);
+        [[maybe_unused]] const size_t appended = AppendFromStream(v, in);
+        assert(appended == values.GetSize());
+        assert(v == values);
+    }
+    // поток обрывается внутри элемента: размер не меняется
+    {
+        SimpleVector<uint32_t> v{1, 2};
+        istringstream in(bytes.substr(0, bytes.size() - 1));
+        try {
+            AppendFromStream(v, in, 10);
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+        assert((v == SimpleVector<uint32_t>{1, 2}));
+    }
+
+    const string path = (filesystem::temp_directory_path() / "simple_vector_append_test.bin").string();
+    {
+        ofstream file(path, ios::binary | ios::trunc);
+        file << bytes;
+    }
+    // обычный файл до конца: место резервируется по размеру файла
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        SimpleVector<uint32_t> v;
+        [[maybe_unused]] const size_t appended = AppendFromFd(v, fd);
+        assert(appended == values.GetSize());
+        assert(v == values && v.GetCapacity() == v.GetSize());
+        [[maybe_unused]] const size_t appended_at_end = AppendFromFd(v, fd);
+        assert(appended_at_end == 0);
+        ::close(fd);
+    }
+    // явное число байт с текущей позиции, затем обрыв
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        SimpleVector<uint32_t> v;
+        [[maybe_unused]] const size_t first_block = AppendFromFd(v, fd, 40);
+        [[maybe_unused]] const size_t second_block = AppendFromFd(v, fd, 40);
+        assert(first_block == 10 && second_block == 10);
+        assert(equal(v.begin(), v.end(), values.begin()));
+        try {
+            AppendFromFd(v, fd, bytes.size());
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+        assert(v.GetSize() == 20);
+        try {
+            AppendFromFd(v, fd, 3);
+            assert(false);
+        } catch (const invalid_argument&) {
+        }
+        ::close(fd);
+    }
+    filesystem::remove(path);
+
+    // канал: размер заранее неизвестен
+    {
+        int fds[2];
+        [[maybe_unused]] const int piped = ::pipe(fds);
+        assert(piped == 0);
+        const SimpleVector<uint32_t> small{5, 6, 7, 8, 9};
+        Serialize(fds[1], small);
+        ::close(fds[1]);
+        SimpleVector<uint32_t> v;
+        [[maybe_unused]] const size_t header = SerializedSize<uint32_t>(0) / sizeof(uint32_t);
+        [[maybe_unused]] const size_t appended = AppendFromFd(v, fds[0]);
+        assert(appended == header + small.GetSize());
+        assert(equal(small.begin(), small.end(), v.begin() + header));
+        ::close(fds[0]);
+    }
+    cout << "Done!" << endl << endl;
+}
+
+// Выполняет action в дочернем процессе и сообщает, завершился ли тот через std::abort()
+template <typename Action>
+bool AbortsInChild(Action action) {
+    cout.flush();
+    const pid_t pid = ::fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        static_cast<void>(freopen("/dev/null", "w", stderr));
+        action();
+        ::_exit(0);
+    }
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT;
+}
+
+void TestHardening() {
+    cout << "Test hardening" << endl;
+    // на уровне 0 те же нарушения ловит assert
+    assert(AbortsInChild([] {
+        SimpleVector<int> v(3);
+        static_cast<void>(v[3]);
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> v;
+        v.PopBack();
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> a{1, 2};
+        SimpleVector<int> b{3, 4};
+        a.Insert(b.begin(), 5);
+    }));
+    assert(AbortsInChild([] {
+        const SimpleVector<int> v{1, 2};
+        static_cast<void>(SimpleVectorConstView<int>(v)[2]);
+    }));
+    assert(!AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        v.Erase(v.begin() + 1);
+        static_cast<void>(v[1]);
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        const size_t indices[] = {1, 0};
+        v.EraseIndices({indices, 2});
+    }));
+    assert(AbortsInChild([] {
+        SegmentedSimpleVector<int> v(3);
+        static_cast<void>(v[3]);
+    }));
+    assert(AbortsInChild([] {
+        const SimpleVector<int> in{1, 2, 3};
+        SimpleVector<int> out(2);
+        Transform(ParallelExecution{}, in, out, [](int x) {
+            return x;
+        });
+    }));
+    const string path = (filesystem::temp_directory_path() / "simple_vector_hardening_test.bin").string();
+    assert(AbortsInChild([&path] {
+        MappedSimpleVector<int> v(path);
+        v.PopBack();
+    }));
+    filesystem::remove(path);
+#if SIMPLE_VECTOR_HARDENING >= 2
+    // итератор устаревает после перевыделения, но не после роста в пределах вместимости
+    assert(AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        const auto it = v.begin();
+        v.PushBack(4);
+        static_cast<void>(*it);
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        const auto it = v.cbegin();
+        v.ShrinkToFit();
+        v.Reserve(8);
+        v.Erase(it);
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        const auto it = v.begin();
+        SimpleVector<int> moved(std::move(v));
+        static_cast<void>(*it);
+    }));
+    assert(AbortsInChild([] {
+        SimpleVector<int> v{1, 2, 3};
+        static_cast<void>(*v.end());
+    }));
+    SimpleVector<int> v{1, 2, 3};
+    v.Reserve(8);
+    [[maybe_unused]] const auto it = v.begin();
+    v.PushBack(4);
+    v.Insert(v.cbegin() + 1, 7);
+    assert(*it == 1 && it + 5 == v.end());
+#else
+    static_assert(is_same_v<SimpleVector<int>::Iterator, int*>);
+#endif
+    cout << "Done!" << endl << endl;
+}
+
+void TestHashing() {
+    cout << "Test hashing" << endl;
+    // равные векторы получают равный хеш, любая длина хвоста после блоков по 48 байт
+    for (size_t size = 0; size < 70; ++size) {
+        SimpleVector<uint32_t> a(size);
+        iota(a.begin(), a.end(), 1u);
+        const SimpleVector<uint32_t> b = a;
+        assert(hash<SimpleVector<uint32_t>>{}(a) == hash<SimpleVector<uint32_t>>{}(b));
+        assert(SimpleVectorHash{}(a) == hash<SimpleVectorView<const uint32_t>>{}(SimpleVectorConstView<uint32_t>(b)));
+        if (size > 0) {
+            a[size - 1] ^= 1;
+            assert(SimpleVectorHash{}(a) != SimpleVectorHash{}(b));
+        }
+    }
+    const SimpleVector<uint8_t> bytes{1, 2, 3};
+    assert(SimpleVectorHash{}(bytes) != SimpleVectorHash{}(SimpleVectorConstView<uint8_t>(bytes).Subview(0, 2)));
+
+    // у float равенство не побайтовое: 0.0 == -0.0
+    assert(SimpleVectorHash{}(SimpleVector<float>{0.0f, 1.0f}) == SimpleVectorHash{}(SimpleVector<float>{-0.0f, 1.0f}));
+    assert(SimpleVectorHash{}(SimpleVector<string>{"ab", "c"}) != SimpleVectorHash{}(SimpleVector<string>{"a", "bc"}));
+
+    // ключи-последовательности токенов
+    unordered_map<SimpleVector<uint32_t>, int> counts;
+    const SimpleVector<uint32_t> tokens{5, 1, 5, 1, 5, 1, 7};
+    for (size_t i = 0; i + 2 <= tokens.GetSize(); ++i) {
+        ++counts[SimpleVector<uint32_t>{tokens[i], tokens[i + 1]}];
+    }
+    assert(counts.size() == 3 && (counts[{5, 1}] == 3) && (counts[{1, 5}] == 2) && (counts[{1, 7}] == 1));
+
+    // инкрементальный хеш совпадает с посчитанным заново после любых изменений
+    HashedSimpleVector<uint32_t> hashed;
+    for (uint32_t i = 0; i < 100; ++i) {
+        hashed.PushBack(i * 7);
+    }
+    hashed.Set(10, 1);
+    hashed.PopBack();
+    hashed.PopBack();
+    SimpleVector<uint32_t> rebuilt(hashed.Get());
+    assert(hashed.GetHash() == IncrementalHash<uint32_t>::Of(rebuilt).Get());
+    HashedSimpleVector<uint32_t> same(std::move(rebuilt));
+    assert(same == hashed && hash<HashedSimpleVector<uint32_t>>{}(same) == hashed.GetHash());
+    same.Set(10, 2);
+    assert(same != hashed && same.GetHash() != hashed.GetHash());
+    same.Clear();
+    assert(same.GetHash() == HashedSimpleVector<uint32_t>().GetHash());
+
+    unordered_set<HashedSimpleVector<string>> phrases;
+    phrases.insert(HashedSimpleVector<string>{"to", "be"});
+    HashedSimpleVector<string> phrase;
+    phrase.PushBack("to");
+    phrase.PushBack("be");
+    assert(phrases.count(phrase) == 1);
+
+    // скользящее окно: каждая 3-грамма за O(1)
+    IncrementalHash<uint32_t> window;
+    for (size_t i = 0; i < tokens.GetSize(); ++i) {
+        window.Append(tokens[i]);
+        if (window.GetSize() > 3) {
+            window.RemoveFront(tokens[i - 3]);
+        }
+        if (window.GetSize() == 3) {
+            assert(window == IncrementalHash<uint32_t>::Of(SimpleVectorConstView<uint32_t>(tokens).Subview(i - 2, 3)));
+        }
+    }
+    cout << "Done!" << endl << endl;
+}
+
 int main() {
     TestTemporaryObjConstructor();
     TestTemporaryObjOperator();
@@ -158,5 +1945,33 @@ int main() {
     TestNoncopiablePushBack();
     TestNoncopiableInsert();
     TestNoncopiableErase();
+    TestUninitializedStorage();
+    TestEmplace();
+    TestPolymorphicAllocator();
+    TestTriviallyRelocatable();
+    TestGrowthPolicy();
+    TestSmallVector();
+    TestStrongGuarantee();
+    TestRangeOperations();
+    TestDefaultInitResize();
+    TestShrinkToFit();
+    TestParallelBulkOperations();
+    TestSimdComparisons();
+    TestMappedVector();
+    TestSerialization();
+    TestViews();
+    TestAdoptAndRelease();
+    TestConcurrentVector();
+    TestSegmentedVector();
+    TestFastErase();
+    TestSoAVector();
+    TestAlignedAllocator();
+    TestArenaAllocator();
+    TestCowVector();
+    TestStaticVector();
+    TestParallelAlgorithms();
+    TestStreamingAppend();
+    TestHardening();
+    TestHashing();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Аллокатор поверх malloc/free. В отличие от std::allocator умеет reallocate,
+// поэтому SimpleVector с тривиально перемещаемыми элементами растёт через realloc,
+// который может расширить блок на месте без копирования
+template <typename Type>
+class MallocAllocator {
+    static_assert(alignof(Type) <= alignof(std::max_align_t),
+                  "malloc does not guarantee alignment of over-aligned types");
+
+public:
+    using value_type = Type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename Other>
+    MallocAllocator(const MallocAllocator<Other>&) noexcept {
+    }
+
+    [[nodiscard]] Type* allocate(size_t size) {
+        return static_cast<Type*>(CheckAllocated(std::malloc(BytesFor(size))));
+    }
+
+    void deallocate(Type* p, size_t /*size*/) noexcept {
+        std::free(p);
+    }
+
+    // Меняет размер блока p с old_size на new_size элементов, побайтово сохраняя содержимое.
+    // Возвращает новый адрес блока. При ошибке выбрасывает std::bad_alloc, блок p остаётся валидным
+    [[nodiscard]] Type* reallocate(Type* p, size_t /*old_size*/, size_t new_size) {
+        return static_cast<Type*>(CheckAllocated(std::realloc(p, BytesFor(new_size))));
+    }
+
+    // Расширяет блок p на месте, если malloc уже выделил под него не меньше new_size элементов.
+    // Без glibc размер блока узнать нельзя, и расширение всегда неуспешно
+    bool expand([[maybe_unused]] Type* p, size_t /*old_size*/, [[maybe_unused]] size_t new_size) noexcept {
+#if defined(__GLIBC__)
+        return new_size <= malloc_usable_size(p) / sizeof(Type);
+#else
+        return false;
+#endif
+    }
+
+private:
+    static size_t BytesFor(size_t size) {
+        if (size > static_cast<size_t>(-1) / sizeof(Type)) {
+            throw std::bad_array_new_length{};
+        }
+        return size * sizeof(Type);
+    }
+
+    static void* CheckAllocated(void* p) {
+        if (p == nullptr) {
+            throw std::bad_alloc{};
+        }
+        return p;
+    }
+};
+
+template <typename Type, typename Other>
+bool operator==(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return true;
+}
+
+template <typename Type, typename Other>
+bool operator!=(const MallocAllocator<Type>&, const MallocAllocator<Other>&) noexcept {
+    return false;
+}
@@ -0,0 +1,383 @@
+#pragma once
+
+// Вектор тривиально копируемых элементов, хранящий их в отображённом в память файле.
+// Файл содержит ровно GetSize() * sizeof(Type) байт элементов без заголовка, поэтому
+// данные, записанные одним процессом, другой открывает без чтения и разбора:
+// страницы подгружаются из page cache при первом обращении.
+// Рост увеличивает файл через ftruncate и отображение через mremap (на Linux;
+// в других системах отображение создаётся заново). При закрытии файл, открытый
+// для записи, усекается до размера.
+// Работает только в POSIX-системах
+
+#include "hardening.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Режим открытия файла MappedSimpleVector
+enum class MappedMode {
+    kReadWrite,  // чтение и запись; отсутствующий файл создаётся
+    kReadOnly,   // только чтение: файл должен существовать, размер и содержимое не меняются
+};
+
+// Подсказки ядру о характере доступа к отображению (madvise)
+enum class MappedAdvice {
+    kNormal,
+    kSequential,  // последовательное чтение: упреждающая подкачка, быстрое вытеснение прочитанного
+    kRandom,      // случайный доступ: без упреждающей подкачки
+    kWillNeed,    // начать подкачку всего отображения заранее
+    kHugePage,    // использовать прозрачные большие страницы, где это поддерживается
+};
+
+template <typename Type>
+class MappedSimpleVector {
+    static_assert(std::is_trivially_copyable_v<Type>, "file-backed elements must be trivially copyable");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    // Открывает файл path в режиме mode; для чтения и записи файл создаётся при отсутствии.
+    // Содержимое файла становится элементами вектора. В режиме только для чтения отображение
+    // защищено от записи: методы, меняющие размер, отвергают вызов, а запись через
+    // неконстантную ссылку на элемент завершается сигналом SIGSEGV.
+    // Выбрасывает std::system_error при ошибке ввода-вывода и std::invalid_argument,
+    // если размер файла не кратен sizeof(Type)
+    explicit MappedSimpleVector(const std::string& path, MappedMode mode = MappedMode::kReadWrite)
+        : read_only_(mode == MappedMode::kReadOnly) {
+        fd_ = read_only_ ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                         : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) {
+            ThrowSystemError("open " + path);
+        }
+        try {
+            struct stat st {};
+            if (::fstat(fd_, &st) != 0) {
+                ThrowSystemError("fstat " + path);
+            }
+            const size_t bytes = static_cast<size_t>(st.st_size);
+            if (bytes % sizeof(Type) != 0) {
+                throw std::invalid_argument{"file size is not a multiple of the element size"};
+            }
+            if (bytes != 0) {
+                Map(bytes / sizeof(Type));
+            }
+            size_ = bytes / sizeof(Type);
+        } catch (...) {
+            Unmap();
+            ::close(fd_);
+            throw;
+        }
+    }
+
+    MappedSimpleVector(const MappedSimpleVector&) = delete;
+    MappedSimpleVector& operator=(const MappedSimpleVector&) = delete;
+
+    MappedSimpleVector(MappedSimpleVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , read_only_(other.read_only_) {
+    }
+
+    MappedSimpleVector& operator=(MappedSimpleVector&& rhs) noexcept {
+        if (&rhs != this) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            read_only_ = rhs.read_only_;
+        }
+        return *this;
+    }
+
+    ~MappedSimpleVector() {
+        Close();
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива: сколько элементов помещается в файл без его увеличения
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, открыт ли файл только для чтения
+    bool IsReadOnly() const noexcept {
+        return read_only_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return data_[index];
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Увеличивает файл так, чтобы в нём помещалось new_capacity элементов.
+    // В режиме только для чтения он, как и Resize, PushBack и Append, выбрасывает std::logic_error
+    void Reserve(size_t new_capacity) {
+        RequireWritable();
+        if (new_capacity > capacity_) {
+            Remap(new_capacity);
+        }
+    }
+
+    // Обнуляет размер массива, не изменяя вместимость. Файл не должен быть открыт только для чтения
+    void Clear() noexcept {
+        SIMPLE_VECTOR_CHECK(!read_only_, "Clear on read-only mapping");
+        size_ = 0;
+    }
+
+    // Изменяет размер массива. Новые элементы получают значение Type{}
+    void Resize(size_t new_size) {
+        RequireWritable();
+        if (new_size > capacity_) {
+            Remap(std::max(capacity_ * 2, new_size));
+        }
+        if (new_size > size_) {
+            // после ftruncate хвост файла и так нулевой, но память могла остаться от Clear или PopBack
+            std::fill(end(), begin() + new_size, Type{});
+        }
+        size_ = new_size;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        RequireWritable();
+        if (size_ == capacity_) {
+            // item может лежать в отображении, которое mremap перенесёт
+            const Type copy = item;
+            Remap(std::max<size_t>(capacity_ * 2, 1));
+            data_[size_++] = copy;
+            return;
+        }
+        data_[size_++] = item;
+    }
+
+    // Добавляет count элементов из массива items одним копированием.
+    // items может указывать на элементы самого вектора
+    void Append(const Type* items, size_t count) {
+        RequireWritable();
+        if (size_ + count > capacity_) {
+            // как в PushBack: mremap может перенести отображение, поэтому запоминается смещение
+            const std::less<const Type*> before;
+            const bool aliased = data_ != nullptr && !before(items, data_) && before(items, data_ + size_);
+            const size_t offset = aliased ? items - data_ : 0;
+            Remap(std::max(capacity_ * 2, size_ + count));
+            if (aliased) {
+                items = data_ + offset;
+            }
+        }
+        std::copy_n(items, count, end());
+        size_ += count;
+    }
+
+    // Уничтожает последний элемент вектора. Вектор не должен быть пустым
+    // и не должен быть открыт только для чтения
+    void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(!IsEmpty(), "PopBack on empty vector");
+        SIMPLE_VECTOR_CHECK(!read_only_, "PopBack on read-only mapping");
+        --size_;
+    }
+
+    // Передаёт ядру подсказку о том, как будет читаться отображение.
+    // Для пустого вектора ничего не делает
+    void Advise(MappedAdvice advice) {
+        if (capacity_ == 0) {
+            return;
+        }
+        if (::madvise(data_, capacity_ * sizeof(Type), ToMadvise(advice)) != 0) {
+            ThrowSystemError("madvise");
+        }
+    }
+
+    // Записывает изменённые страницы в файл и дожидается завершения записи
+    void Sync() {
+        if (capacity_ != 0 && ::msync(data_, capacity_ * sizeof(Type), MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+    void swap(MappedSimpleVector& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(read_only_, other.read_only_);
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void RequireWritable() const {
+        if (read_only_) {
+            throw std::logic_error{"mapped vector is read-only"};
+        }
+    }
+
+    static int ToMadvise(MappedAdvice advice) noexcept {
+        switch (advice) {
+            case MappedAdvice::kSequential:
+                return MADV_SEQUENTIAL;
+            case MappedAdvice::kRandom:
+                return MADV_RANDOM;
+            case MappedAdvice::kWillNeed:
+                return MADV_WILLNEED;
+            case MappedAdvice::kHugePage:
+#ifdef MADV_HUGEPAGE
+                return MADV_HUGEPAGE;
+#else
+                return MADV_NORMAL;
+#endif
+            case MappedAdvice::kNormal:
+                break;
+        }
+        return MADV_NORMAL;
+    }
+
+    // Устанавливает размер файла и отображения в new_capacity элементов.
+    // При ошибке вектор остаётся прежним
+    void Remap(size_t new_capacity) {
+        const size_t new_bytes = new_capacity * sizeof(Type);
+        const size_t old_bytes = capacity_ * sizeof(Type);
+        if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        void* mapping = MAP_FAILED;
+        const char* call = "mmap";
+#ifdef __linux__
+        if (data_ != nullptr) {
+            call = "mremap";
+            mapping = ::mremap(data_, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        } else
+#endif
+        {
+            mapping = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        }
+        if (mapping == MAP_FAILED) {
+            const int error = errno;
+            // при ошибке возвращаем файлу прежний размер, чтобы он совпадал с отображением
+            [[maybe_unused]] const int restored = ::ftruncate(fd_, static_cast<off_t>(old_bytes));
+            errno = error;
+            ThrowSystemError(call);
+        }
+#ifndef __linux__
+        if (data_ != nullptr) {
+            ::munmap(data_, old_bytes);
+        }
+#endif
+        data_ = static_cast<Type*>(mapping);
+        capacity_ = new_capacity;
+    }
+
+    // Отображает уже существующие capacity элементов файла, не меняя его размер.
+    // В режиме только для чтения отображение защищено от записи
+    void Map(size_t capacity) {
+        const int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* mapping = ::mmap(nullptr, capacity * sizeof(Type), protection, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        data_ = static_cast<Type*>(mapping);
+        capacity_ = capacity;
+    }
+
+    void Unmap() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(data_, capacity_ * sizeof(Type));
+            data_ = nullptr;
+            capacity_ = 0;
+        }
+    }
+
+    // Отпускает отображение и усекает файл до фактического размера массива
+    void Close() noexcept {
+        if (fd_ < 0) {
+            return;
+        }
+        Unmap();
+        if (!read_only_) {
+            [[maybe_unused]] const int truncated = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(Type)));
+        }
+        ::close(fd_);
+        fd_ = -1;
+        size_ = 0;
+    }
+
+    int fd_ = -1;
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+    bool read_only_ = false;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Параметры параллельного выполнения массовых операций SimpleVector.
+// Передаётся первым аргументом в перегрузки конструкторов, Resize и сравнений.
+// Диапазон делится на непрерывные куски, по одному на поток. Границы кусков выровнены
+// по страницам реального адреса буфера, так что, когда размер элемента делит размер страницы,
+// каждую страницу первым трогает ровно один поток и, по правилу first-touch, она выделяется
+// на NUMA-узле этого потока; иначе общей для двух потоков остаётся лишь страница на границе.
+// Пула потоков нет: каждый вызов создаёт потоки заново и дожидается их. Это стоит десятков
+// микросекунд на поток и окупается только на больших диапазонах, поэтому min_size велик
+struct ParallelExecution {
+    // Число потоков; 0 — std::thread::hardware_concurrency()
+    size_t threads = 0;
+    // Диапазоны меньше этого числа элементов обрабатываются последовательно в вызывающем потоке
+    size_t min_size = size_t{1} << 16;
+};
+
+namespace parallel_detail {
+
+constexpr size_t kPageSize = 4096;
+
+// Число элементов на одной странице, кратное которому выравниваются границы кусков
+template <typename Type>
+constexpr size_t ChunkAlignment() noexcept {
+    return std::max<size_t>(kPageSize / sizeof(Type), 1);
+}
+
+// Сетка, на которую ложатся границы кусков: каждая граница, кроме нулевой, равна offset + k * step
+struct ChunkGrid {
+    size_t step = 1;
+    size_t offset = 0;
+};
+
+// Сетка для массива, начинающегося с data: границы кусков приходятся на начала страниц,
+// если начало страницы совпадает с началом какого-то элемента
+template <typename Type>
+ChunkGrid PageGrid(const Type* data) noexcept {
+    const size_t step = ChunkAlignment<Type>();
+    const size_t to_page = (kPageSize - reinterpret_cast<std::uintptr_t>(data) % kPageSize) % kPageSize;
+    if (to_page % sizeof(Type) != 0) {
+        return {step, 0};
+    }
+    return {step, to_page / sizeof(Type) % step};
+}
+
+inline size_t ThreadCount(const ParallelExecution& policy) noexcept {
+    const size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    return std::max<size_t>(threads, 1);
+}
+
+}  // namespace parallel_detail
+
+// Вызывает func(begin, end) для непересекающихся кусков [0, count), покрывающих весь диапазон,
+// в нескольких потоках. Границы кусков лежат на сетке grid; для пустого диапазона func не вызывается.
+// Если какой-то кусок бросил исключение, для всех успешно обработанных кусков вызывается
+// undo(begin, end), после чего первое исключение пробрасывается. Сама func должна
+// откатывать свой кусок при исключении
+template <typename Func, typename Undo>
+void ParallelFor(const ParallelExecution& policy, size_t count, parallel_detail::ChunkGrid grid, Func func, Undo undo) {
+    if (count == 0) {
+        return;
+    }
+    const size_t threads = parallel_detail::ThreadCount(policy);
+    if (count < policy.min_size || threads == 1) {
+        func(size_t{0}, count);
+        return;
+    }
+    size_t chunk = (count + threads - 1) / threads;
+    chunk = (chunk + grid.step - 1) / grid.step * grid.step;
+    // нулевой кусок дополнительно забирает элементы до первой границы сетки
+    const size_t chunks = count > grid.offset ? (count - grid.offset + chunk - 1) / chunk : 1;
+    const auto chunk_begin = [&](size_t index) {
+        return index == 0 ? 0 : std::min(grid.offset + index * chunk, count);
+    };
+    const auto chunk_end = [&](size_t index) {
+        return std::min(grid.offset + (index + 1) * chunk, count);
+    };
+
+    std::vector<std::exception_ptr> errors(chunks);
+    auto run = [&](size_t index) {
+        try {
+            func(chunk_begin(index), chunk_end(index));
+        } catch (...) {
+            errors[index] = std::current_exception();
+        }
+    };
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        try {
+            for (size_t index = 1; index < chunks; ++index) {
+                workers.emplace_back(run, index);
+            }
+        } catch (...) {
+            // поток не создался: оставшиеся куски обрабатываются здесь
+            for (size_t index = workers.size() + 1; index < chunks; ++index) {
+                run(index);
+            }
+        }
+        run(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    const auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& e) {
+        return e != nullptr;
+    });
+    if (failed == errors.end()) {
+        return;
+    }
+    for (size_t index = 0; index < chunks; ++index) {
+        if (errors[index] == nullptr) {
+            undo(chunk_begin(index), chunk_end(index));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
+
+template <typename Func>
+void ParallelFor(const ParallelExecution& policy, size_t count, parallel_detail::ChunkGrid grid, Func func) {
+    ParallelFor(policy, count, grid, func, [](size_t, size_t) {});
+}
+
+// Возвращает наименьший индекс i из [0, count), для которого pred(i) истинно, либо count.
+// Потоки прекращают поиск, как только находка в более раннем куске делает их кусок ненужным
+template <typename Pred>
+size_t ParallelFindFirst(const ParallelExecution& policy, size_t count, parallel_detail::ChunkGrid grid, Pred pred) {
+    constexpr size_t kBlock = 4096;
+    std::atomic<size_t> found{count};
+    ParallelFor(policy, count, grid, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end && block < found.load(std::memory_order_relaxed); block += kBlock) {
+            const size_t block_end = std::min(block + kBlock, end);
+            for (size_t i = block; i < block_end; ++i) {
+                if (pred(i)) {
+                    size_t current = found.load(std::memory_order_relaxed);
+                    while (i < current && !found.compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+                    }
+                    return;
+                }
+            }
+        }
+    });
+    return found.load();
+}
@@ -0,0 +1,477 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Размер куска SegmentedSimpleVector по умолчанию: степень двойки, около 64 КБ элементов
+template <typename Type>
+constexpr size_t DefaultChunkSize() noexcept {
+    size_t size = 1;
+    while (size * 2 * sizeof(Type) <= (size_t{1} << 16)) {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор, хранящий элементы в кусках по ChunkSize штук и таблицу указателей на куски.
+// При росте выделяется только новый кусок, а элементы никогда не переносятся, поэтому
+// PushBack всегда O(1) без копирования и пика памяти, а ссылки на элементы не инвалидируются.
+// Итераторы хранят указатель на сам вектор и индекс, поэтому рост, перевыделяющий таблицу кусков,
+// не инвалидирует и их; после swap или перемещения они по-прежнему относятся к исходному объекту.
+// Доступ по индексу стоит одного лишнего чтения из таблицы. Из середины вставлять и удалять
+// нельзя: вектор рассчитан на рост с конца.
+// Как и SimpleVector, элементы создаются через std::allocator_traits<Alloc>
+template <typename Type, typename Alloc = std::allocator<Type>, size_t ChunkSize = DefaultChunkSize<Type>()>
+class SegmentedSimpleVector {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using TableAlloc = typename AllocTraits::template rebind_alloc<Type*>;
+
+    static constexpr size_t kChunkMask = ChunkSize - 1;
+
+    template <typename Value>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+
+        BasicIterator() noexcept = default;
+
+        // Изменяемый итератор приводится к константному
+        template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other*, Value*>>>
+        BasicIterator(const BasicIterator<Other>& other) noexcept
+            : owner_(other.owner_)
+            , index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return owner_->chunks_[index_ / ChunkSize][index_ & kChunkMask];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        BasicIterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        BasicIterator operator--(int) noexcept {
+            BasicIterator copy = *this;
+            --index_;
+            return copy;
+        }
+
+        BasicIterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator+(difference_type offset, BasicIterator it) noexcept {
+            return it += offset;
+        }
+
+        friend BasicIterator operator-(BasicIterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+    private:
+        friend class SegmentedSimpleVector;
+        template <typename>
+        friend class BasicIterator;
+
+        BasicIterator(const SegmentedSimpleVector* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+        }
+
+        // таблица кусков читается через вектор при каждом обращении: она переезжает при росте
+        const SegmentedSimpleVector* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using Iterator = BasicIterator<Type>;
+    using ConstIterator = BasicIterator<const Type>;
+    using AllocatorType = Alloc;
+
+    SegmentedSimpleVector() = default;
+
+    explicit SegmentedSimpleVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+        , chunks_(TableAlloc(alloc)) {
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SegmentedSimpleVector(size_t size, const Alloc& alloc = Alloc())
+        : SegmentedSimpleVector(alloc) {
+        Resize(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SegmentedSimpleVector(size_t size, const Type& value, const Alloc& alloc = Alloc())
+        : SegmentedSimpleVector(alloc) {
+        Reserve(size);
+        while (size_ < size) {
+            EmplaceBack(value);
+        }
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SegmentedSimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc())
+        : SegmentedSimpleVector(alloc) {
+        Reserve(init.size());
+        for (const Type& item : init) {
+            EmplaceBack(item);
+        }
+    }
+
+    // Делегирующие конструкторы гарантируют вызов деструктора, если копирование элемента
+    // бросит исключение
+    SegmentedSimpleVector(const SegmentedSimpleVector& other)
+        : SegmentedSimpleVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+    }
+
+    SegmentedSimpleVector(const SegmentedSimpleVector& other, const Alloc& alloc)
+        : SegmentedSimpleVector(alloc) {
+        Reserve(other.size_);
+        for (const Type& item : other) {
+            EmplaceBack(item);
+        }
+    }
+
+    // Таблица кусков переходит целиком, элементы не трогаются
+    SegmentedSimpleVector(SegmentedSimpleVector&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    ~SegmentedSimpleVector() {
+        Clear();
+        ReleaseChunks(0);
+    }
+
+    // Строгая гарантия: копия строится до того, как this изменится
+    SegmentedSimpleVector& operator=(const SegmentedSimpleVector& rhs) {
+        if (&rhs != this) {
+            SegmentedSimpleVector rhs_copy(rhs, AllocTraits::propagate_on_container_copy_assignment::value
+                                                    ? rhs.alloc_ : alloc_);
+            swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    // Как у SimpleVector: если куски rhs забрать нельзя из-за неравного аллокатора,
+    // элементы перемещаются поштучно
+    SegmentedSimpleVector& operator=(SegmentedSimpleVector&& rhs) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+        if (&rhs == this) {
+            return *this;
+        }
+        if (AllocTraits::propagate_on_container_move_assignment::value || alloc_ == rhs.alloc_) {
+            Clear();
+            ReleaseChunks(0);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            }
+            chunks_ = std::move(rhs.chunks_);
+            size_ = std::exchange(rhs.size_, 0);
+        } else {
+            SegmentedSimpleVector moved(alloc_);
+            moved.Reserve(rhs.size_);
+            for (Type& item : rhs) {
+                moved.EmplaceBack(std::move(item));
+            }
+            swap(moved);
+            rhs.Clear();
+        }
+        return *this;
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость выделенных кусков
+    size_t GetCapacity() const noexcept {
+        return chunks_.GetSize() * ChunkSize;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает копию аллокатора вектора
+    Alloc GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return chunks_[index / ChunkSize][index & kChunkMask];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return chunks_[index / ChunkSize][index & kChunkMask];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return (*this)[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return (*this)[index];
+    }
+
+    // Выделяет куски так, чтобы вместимость была не меньше new_capacity.
+    // Таблица кусков резервируется ровно под них. Элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        const size_t chunks = (new_capacity + ChunkSize - 1) / ChunkSize;
+        if (chunks <= chunks_.GetSize()) {
+            return;
+        }
+        chunks_.Reserve(chunks);
+        while (chunks_.GetSize() < chunks) {
+            AddChunk();
+        }
+    }
+
+    // Освобождает куски, в которых не осталось элементов
+    void ShrinkToFit() {
+        ReleaseChunks((size_ + ChunkSize - 1) / ChunkSize);
+        chunks_.ShrinkToFit();
+    }
+
+    // Уничтожает все элементы, не освобождая куски
+    void Clear() noexcept {
+        while (size_ > 0) {
+            PopBack();
+        }
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type,
+    // при уменьшении лишние элементы уничтожаются.
+    // Если конструктор элемента бросит исключение, размер не изменится
+    void Resize(size_t new_size) {
+        const size_t old_size = size_;
+        while (size_ > new_size) {
+            PopBack();
+        }
+        Reserve(new_size);
+        try {
+            while (size_ < new_size) {
+                EmplaceBack();
+            }
+        } catch (...) {
+            while (size_ > old_size) {
+                PopBack();
+            }
+            throw;
+        }
+    }
+
+    Iterator begin() noexcept {
+        return {this, 0};
+    }
+
+    Iterator end() noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator begin() const noexcept {
+        return {this, 0};
+    }
+
+    ConstIterator end() const noexcept {
+        return {this, size_};
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места выделяет ещё один кусок, не трогая существующие элементы
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args прямо в конце вектора и возвращает ссылку на него
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ == GetCapacity()) {
+            AddChunk();
+        }
+        Type* slot = chunks_[size_ / ChunkSize] + (size_ & kChunkMask);
+        AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    // Уничтожает последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(!IsEmpty(), "PopBack on empty vector");
+        --size_;
+        AllocTraits::destroy(alloc_, chunks_[size_ / ChunkSize] + (size_ & kChunkMask));
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SegmentedSimpleVector& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        } else {
+            assert(alloc_ == other.alloc_);
+        }
+        chunks_.swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+private:
+    // Выделяет ещё один кусок. Таблица растёт как обычный SimpleVector, то есть геометрически,
+    // поэтому рост по одному элементу перевыделяет её O(log n) раз
+    void AddChunk() {
+        Type* chunk = AllocTraits::allocate(alloc_, ChunkSize);
+        try {
+            chunks_.PushBack(chunk);
+        } catch (...) {
+            AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+            throw;
+        }
+    }
+
+    // Освобождает куски начиная с first; элементов в них быть не должно
+    void ReleaseChunks(size_t first) noexcept {
+        while (chunks_.GetSize() > first) {
+            AllocTraits::deallocate(alloc_, chunks_[chunks_.GetSize() - 1], ChunkSize);
+            chunks_.PopBack();
+        }
+    }
+
+    Alloc alloc_;
+    SimpleVector<Type*, TableAlloc> chunks_;
+    size_t size_ = 0;
+};
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator==(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                       const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return (&lhs == &rhs) || (lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+}
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator!=(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                       const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator<(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                      const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator<=(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                       const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator>(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                      const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename Type, typename Alloc, size_t ChunkSize>
+inline bool operator>=(const SegmentedSimpleVector<Type, Alloc, ChunkSize>& lhs,
+                       const SegmentedSimpleVector<Type, Alloc, ChunkSize>& rhs) {
+    return !(lhs < rhs);
+}
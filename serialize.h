@@ -0,0 +1,414 @@
+#pragma once
+#include "simple_vector.h"
+
+// Двоичный формат SimpleVector тривиально копируемых элементов:
+// заголовок SerializedHeader, нулевые байты до смещения data_offset и элементы
+// в памяти как есть. Смещение данных кратно их выравниванию, поэтому сериализованный
+// буфер или отображённый файл можно читать на месте через DeserializeView.
+// Формат не переносим между платформами с разным порядком байт или размером элементов:
+// Deserialize проверяет это по заголовку и отвергает несовместимые данные
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+struct SerializedHeader {
+    static constexpr uint32_t kMagic = 0x43455653;  // "SVEC" в little-endian
+    static constexpr uint16_t kVersion = 1;
+    static constexpr uint8_t kLittleEndian = 1;
+    static constexpr uint8_t kBigEndian = 2;
+
+    uint32_t magic = kMagic;
+    uint16_t version = kVersion;
+    uint8_t endianness = 0;
+    uint8_t reserved = 0;
+    uint32_t element_size = 0;
+    uint32_t alignment = 0;
+    uint64_t count = 0;
+    uint64_t data_offset = 0;  // от начала заголовка
+};
+
+static_assert(sizeof(SerializedHeader) == 32 && std::is_trivially_copyable_v<SerializedHeader>);
+
+namespace serialize_detail {
+
+inline uint8_t NativeEndianness() noexcept {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return SerializedHeader::kBigEndian;
+#else
+    return SerializedHeader::kLittleEndian;
+#endif
+}
+
+// Наибольшее выравнивание данных, которое умеет задавать заголовок без лишнего заполнения
+constexpr size_t kMaxPadding = 64;
+
+template <typename Type>
+SerializedHeader MakeHeader(size_t count) noexcept {
+    SerializedHeader header;
+    header.endianness = NativeEndianness();
+    header.element_size = sizeof(Type);
+    header.alignment = alignof(Type);
+    header.count = count;
+    header.data_offset = (sizeof(SerializedHeader) + alignof(Type) - 1) / alignof(Type) * alignof(Type);
+    return header;
+}
+
+// Проверяет, что данные с заголовком header можно читать как массив Type
+template <typename Type>
+void CheckHeader(const SerializedHeader& header) {
+    if (header.magic != SerializedHeader::kMagic || header.version != SerializedHeader::kVersion) {
+        throw std::invalid_argument{"not a serialized SimpleVector"};
+    }
+    if (header.endianness != NativeEndianness()) {
+        throw std::invalid_argument{"serialized SimpleVector has foreign byte order"};
+    }
+    if (header.element_size != sizeof(Type) || header.alignment != alignof(Type)) {
+        throw std::invalid_argument{"serialized SimpleVector has different element type"};
+    }
+    if (header.data_offset != MakeHeader<Type>(0).data_offset) {
+        throw std::invalid_argument{"serialized SimpleVector has unexpected data offset"};
+    }
+}
+
+template <typename Type>
+void RequireTriviallyCopyable() {
+    static_assert(std::is_trivially_copyable_v<Type>, "only trivially copyable elements can be serialized");
+    static_assert(alignof(Type) <= kMaxPadding, "element alignment is too large for the serialized format");
+}
+
+// Пишет все iovcnt буферов, повторяя writev после частичной записи и EINTR
+inline void WriteAll(int fd, iovec* iov, int iovcnt) {
+    while (iovcnt > 0) {
+        const ssize_t written = ::writev(fd, iov, iovcnt);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+        size_t left = static_cast<size_t>(written);
+        while (iovcnt > 0 && left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --iovcnt;
+        }
+        if (iovcnt > 0) {
+            iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+            iov->iov_len -= left;
+        }
+    }
+}
+
+inline void ReadAll(int fd, void* data, size_t size) {
+    char* dest = static_cast<char*>(data);
+    while (size > 0) {
+        const ssize_t got = ::read(fd, dest, size);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (got == 0) {
+            throw std::invalid_argument{"truncated serialized SimpleVector"};
+        }
+        dest += got;
+        size -= static_cast<size_t>(got);
+    }
+}
+
+inline void ReadAll(std::istream& in, void* data, size_t size) {
+    if (!in.read(static_cast<char*>(data), static_cast<std::streamsize>(size))) {
+        throw std::invalid_argument{"truncated serialized SimpleVector"};
+    }
+}
+
+// Читает до size байт, пока не заполнит буфер или не встретит конец данных; возвращает
+// число прочитанных байт. Меньше size оно бывает только в конце файла или потока
+inline size_t ReadSome(int fd, void* data, size_t size) {
+    char* dest = static_cast<char*>(data);
+    size_t total = 0;
+    while (total < size) {
+        const ssize_t got = ::read(fd, dest + total, size - total);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (got == 0) {
+            break;
+        }
+        total += static_cast<size_t>(got);
+    }
+    return total;
+}
+
+inline size_t ReadSome(std::istream& in, void* data, size_t size) {
+    in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+    if (in.bad()) {
+        throw std::ios_base::failure{"read"};
+    }
+    return static_cast<size_t>(in.gcount());
+}
+
+inline bool AtEnd(int) noexcept {
+    return false;
+}
+
+inline bool AtEnd(std::istream& in) {
+    return in.peek() == std::istream::traits_type::eof();
+}
+
+constexpr size_t kUnlimited = static_cast<size_t>(-1);
+
+// Сколько байт осталось до конца обычного файла от текущей позиции; для каналов, сокетов
+// и потоков — kUnlimited, то есть неизвестно
+inline size_t RemainingBytes(int fd) noexcept {
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return kUnlimited;
+    }
+    const off_t offset = ::lseek(fd, 0, SEEK_CUR);
+    if (offset < 0) {
+        return kUnlimited;
+    }
+    return offset < st.st_size ? static_cast<size_t>(st.st_size - offset) : 0;
+}
+
+inline size_t RemainingBytes(std::istream&) noexcept {
+    return kUnlimited;
+}
+
+// Сколько байт Deserialize резервирует по заголовку, который нечем проверить: испорченный
+// счётчик элементов не должен приводить к огромному выделению до первого чтения
+constexpr size_t kMaxUnverifiedReserve = size_t{1} << 24;
+
+// Дописывает в v элементы, прочитанные из source, пока данные не кончатся или не будет
+// прочитано max_bytes байт; сначала резервирует место под hint элементов. Каждый блок
+// читается прямо в неинициализированный хвост буфера, а размер вектора меняется один раз
+// на блок. Возвращает число дописанных байт. Если данные обрываются внутри элемента
+// или чтение не удалось, вектор возвращается к исходному размеру
+template <typename Type, typename Alloc, typename Growth, typename Source>
+size_t AppendBlocks(SimpleVector<Type, Alloc, Growth>& v, Source& source, size_t max_bytes, size_t hint) {
+    const size_t old_size = v.GetSize();
+    size_t appended = 0;
+    try {
+        if (hint > 0) {
+            v.Reserve(old_size + std::min(hint, kUnlimited / sizeof(Type) - old_size));
+        }
+        bool at_end = false;
+        while (!at_end && appended < max_bytes) {
+            const size_t size = v.GetSize();
+            if (size == v.GetCapacity()) {
+                if (AtEnd(source)) {
+                    break;
+                }
+                size_t capacity = Growth::template NextCapacity<Type>(size, size + 1);
+                if (max_bytes != kUnlimited) {
+                    const size_t left = (max_bytes - appended + sizeof(Type) - 1) / sizeof(Type);
+                    capacity = std::min(capacity, size + left);
+                }
+                v.Reserve(capacity);
+            }
+            const size_t room = v.GetCapacity() - size;
+            v.ResizeAndOverwrite(size + room, [&](Type* data, size_t) {
+                const size_t want = room <= (max_bytes - appended) / sizeof(Type)
+                                        ? room * sizeof(Type) : max_bytes - appended;
+                const size_t got = ReadSome(source, data + size, want);
+                at_end = got < want;
+                appended += got;
+                return size + got / sizeof(Type);
+            });
+        }
+        if (appended % sizeof(Type) != 0) {
+            throw std::invalid_argument{"data ends inside an element"};
+        }
+    } catch (...) {
+        v.ResizeDefaultInit(old_size);
+        throw;
+    }
+    return appended;
+}
+
+// Читает заголовок и заполнение перед данными
+template <typename Type, typename Source>
+SerializedHeader ReadHeader(Source& source) {
+    SerializedHeader header;
+    ReadAll(source, &header, sizeof(header));
+    CheckHeader<Type>(header);
+    char padding[kMaxPadding];
+    ReadAll(source, padding, header.data_offset - sizeof(header));
+    return header;
+}
+
+// Читает header.count элементов после заголовка. Если размер файла известен, обрезанные данные
+// отвергаются до выделения памяти, а буфер выделяется сразу целиком. Иначе заголовку верится
+// только на kMaxUnverifiedReserve байт, а дальше вектор растёт блоками по мере чтения
+template <typename Type, typename Alloc, typename Growth, typename Source>
+SimpleVector<Type, Alloc, Growth> ReadVector(Source& source, const Alloc& alloc) {
+    const SerializedHeader header = ReadHeader<Type>(source);
+    const size_t available = RemainingBytes(source);
+    if (header.count > std::min(available, kUnlimited - 1) / sizeof(Type)) {
+        throw std::invalid_argument{"truncated serialized SimpleVector"};
+    }
+    const size_t bytes = static_cast<size_t>(header.count) * sizeof(Type);
+    const size_t hint = available != kUnlimited ? static_cast<size_t>(header.count)
+                                                : std::min(bytes, kMaxUnverifiedReserve) / sizeof(Type);
+    SimpleVector<Type, Alloc, Growth> result(alloc);
+    if (AppendBlocks(result, source, bytes, hint) < bytes) {
+        throw std::invalid_argument{"truncated serialized SimpleVector"};
+    }
+    return result;
+}
+
+}  // namespace serialize_detail
+
+// Размер сериализованного представления size элементов Type в байтах
+template <typename Type>
+constexpr size_t SerializedSize(size_t size) noexcept {
+    return serialize_detail::MakeHeader<Type>(size).data_offset + size * sizeof(Type);
+}
+
+// Записывает size элементов из data в поток: заголовок и элементы одним вызовом write
+template <typename Type>
+void Serialize(std::ostream& out, const Type* data, size_t size) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    const SerializedHeader header = serialize_detail::MakeHeader<Type>(size);
+    char prefix[serialize_detail::kMaxPadding]{};
+    std::memcpy(prefix, &header, sizeof(header));
+    out.write(prefix, static_cast<std::streamsize>(header.data_offset));
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size * sizeof(Type)));
+}
+
+// Записывает size элементов из data в файловый дескриптор одним writev
+template <typename Type>
+void Serialize(int fd, const Type* data, size_t size) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    const SerializedHeader header = serialize_detail::MakeHeader<Type>(size);
+    char prefix[serialize_detail::kMaxPadding]{};
+    std::memcpy(prefix, &header, sizeof(header));
+    iovec iov[2] = {{prefix, header.data_offset}, {const_cast<Type*>(data), size * sizeof(Type)}};
+    serialize_detail::WriteAll(fd, iov, size != 0 ? 2 : 1);
+}
+
+// Записывает вектор или представление в поток или файловый дескриптор (см. формат в начале файла)
+template <typename Sink, typename Type, typename Alloc, typename Growth>
+void Serialize(Sink&& sink, const SimpleVector<Type, Alloc, Growth>& v) {
+    Serialize(sink, v.Data(), v.GetSize());
+}
+
+template <typename Sink, typename Type>
+void Serialize(Sink&& sink, SimpleVectorView<Type> view) {
+    Serialize(sink, view.begin(), view.GetSize());
+}
+
+// Читает вектор из потока. Элементы читаются крупными блоками прямо в буфер вектора;
+// размер потока неизвестен, поэтому место по заголовку резервируется не больше чем
+// на kMaxUnverifiedReserve байт.
+// Выбрасывает std::invalid_argument, если данные повреждены, обрезаны или записаны
+// для другого типа элементов
+template <typename Type, typename Alloc = std::allocator<Type>, typename Growth = DoublingGrowth>
+SimpleVector<Type, Alloc, Growth> Deserialize(std::istream& in, const Alloc& alloc = Alloc()) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    return serialize_detail::ReadVector<Type, Alloc, Growth>(in, alloc);
+}
+
+// Читает вектор из файлового дескриптора; ошибки ввода-вывода приходят как std::system_error.
+// У обычного файла счётчик из заголовка сверяется с размером файла, и элементы читаются
+// одним read в буфер, выделенный сразу целиком
+template <typename Type, typename Alloc = std::allocator<Type>, typename Growth = DoublingGrowth>
+SimpleVector<Type, Alloc, Growth> Deserialize(int fd, const Alloc& alloc = Alloc()) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    return serialize_detail::ReadVector<Type, Alloc, Growth>(fd, alloc);
+}
+
+// Разбирает size байт по адресу data без копирования элементов: результат — представление
+// внутри буфера. Буфер должен быть выровнен хотя бы как Type (буферы из malloc, new и mmap
+// выровнены) и жить дольше результата
+template <typename Type>
+SimpleVectorConstView<Type> DeserializeView(const void* data, size_t size) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    SerializedHeader header;
+    if (size < sizeof(header)) {
+        throw std::invalid_argument{"truncated serialized SimpleVector"};
+    }
+    std::memcpy(&header, data, sizeof(header));
+    serialize_detail::CheckHeader<Type>(header);
+    if (size < header.data_offset || (size - header.data_offset) / sizeof(Type) < header.count) {
+        throw std::invalid_argument{"truncated serialized SimpleVector"};
+    }
+    const char* items = static_cast<const char*>(data) + header.data_offset;
+    if (reinterpret_cast<uintptr_t>(items) % alignof(Type) != 0) {
+        throw std::invalid_argument{"serialized SimpleVector buffer is misaligned"};
+    }
+    return {reinterpret_cast<const Type*>(items), static_cast<size_t>(header.count)};
+}
+
+// Сырые элементы без заголовка, например суточные выгрузки, которые пишет другая программа
+// на той же платформе. Чтение идёт крупными блоками прямо в буфер вектора, без промежуточного
+// буфера и поэлементных вызовов
+
+// Дописывает в конец v элементы из потока до его конца и возвращает их число.
+// count_hint — ожидаемое число элементов: место под него резервируется заранее, а если
+// оценка верна, вектор не растёт и не проверяет конец потока лишним чтением.
+// Выбрасывает std::invalid_argument, если поток обрывается внутри элемента, и
+// std::ios_base::failure при ошибке чтения; в обоих случаях размер v не меняется
+template <typename Type, typename Alloc, typename Growth>
+size_t AppendFromStream(SimpleVector<Type, Alloc, Growth>& v, std::istream& in, size_t count_hint = 0) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    const size_t bytes = serialize_detail::AppendBlocks(v, in, serialize_detail::kUnlimited, count_hint);
+    if (in.eof()) {
+        in.clear(in.rdstate() & ~std::ios_base::failbit);
+    }
+    return bytes / sizeof(Type);
+}
+
+// Сколько байт читать из файлового дескриптора: всё до конца файла
+constexpr size_t kReadToEnd = serialize_detail::kUnlimited;
+
+// Дописывает в конец v элементы, прочитанные из fd с текущей позиции, и возвращает их число.
+// Явное bytes должно быть кратно размеру элемента, и ровно столько байт должно найтись в файле.
+// С kReadToEnd обычный файл читается до конца, каким он был при вызове, а место под него
+// резервируется сразу по fstat; канал или сокет читается до закрытия с ростом вектора.
+// Ошибки ввода-вывода приходят как std::system_error, обрыв данных — как std::invalid_argument;
+// в обоих случаях размер v не меняется, а позиция в файле остаётся там, где оборвалось чтение
+template <typename Type, typename Alloc, typename Growth>
+size_t AppendFromFd(SimpleVector<Type, Alloc, Growth>& v, int fd, size_t bytes = kReadToEnd) {
+    serialize_detail::RequireTriviallyCopyable<Type>();
+    if (bytes != kReadToEnd && bytes % sizeof(Type) != 0) {
+        throw std::invalid_argument{"byte count is not a multiple of the element size"};
+    }
+    const bool exact = bytes != kReadToEnd;
+    const size_t remaining = serialize_detail::RemainingBytes(fd);
+    if (remaining != serialize_detail::kUnlimited) {
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        if (!exact) {
+            bytes = remaining;
+        }
+    }
+    // явному bytes сверх остатка файла место не резервируется: чтение всё равно оборвётся
+    const size_t expected = std::min(bytes, remaining);
+    const size_t hint = expected != kReadToEnd ? (expected + sizeof(Type) - 1) / sizeof(Type) : 0;
+    const size_t old_size = v.GetSize();
+    const size_t appended = serialize_detail::AppendBlocks(v, fd, bytes, hint);
+    if (exact && appended < bytes) {
+        v.ResizeDefaultInit(old_size);
+        throw std::invalid_argument{"truncated data"};
+    }
+    return appended / sizeof(Type);
+}
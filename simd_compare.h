@@ -0,0 +1,214 @@
+#pragma once
+
+// Сравнение непрерывных массивов для operator== и operator< векторов.
+// Для целых типов равенство проверяется через memcmp, а порядок — поиском первого
+// различающегося байта векторными инструкциями. Для float и double используются
+// векторные сравнения с той же семантикой NaN и -0.0, что у == и <.
+// Набор инструкций выбирается при компиляции: AVX-512BW, AVX2/AVX, SSE2 (всегда есть на x86-64)
+// или NEON на AArch64; без них работает скалярный цикл. Более широкие варианты включаются
+// флагами компилятора, например -mavx2 или -march=native.
+// Для остальных типов и в константных вычислениях используются std::equal
+// и std::lexicographical_compare
+
+#include "constexpr_support.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define SIMPLE_VECTOR_SIMD_X86 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define SIMPLE_VECTOR_SIMD_NEON 1
+#endif
+
+namespace simd_detail {
+
+inline size_t CountTrailingZeros(unsigned long long mask) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    size_t count = 0;
+    for (; (mask & 1) == 0; mask >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+// Индекс первого различающегося байта a и b среди первых size байт, либо size
+inline size_t MismatchBytes(const unsigned char* a, const unsigned char* b, size_t size) noexcept {
+    size_t i = 0;
+#if defined(__AVX512BW__)
+    for (; i + 64 <= size; i += 64) {
+        const __mmask64 differ = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        if (differ != 0) {
+            return i + CountTrailingZeros(differ);
+        }
+    }
+#endif
+#if defined(__AVX2__)
+    for (; i + 32 <= size; i += 32) {
+        const __m256i equal = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+        const unsigned differ = ~static_cast<unsigned>(_mm256_movemask_epi8(equal));
+        if (differ != 0) {
+            return i + CountTrailingZeros(differ);
+        }
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+    for (; i + 16 <= size; i += 16) {
+        const __m128i equal = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+        const unsigned differ = ~static_cast<unsigned>(_mm_movemask_epi8(equal)) & 0xFFFFu;
+        if (differ != 0) {
+            return i + CountTrailingZeros(differ);
+        }
+    }
+#elif defined(SIMPLE_VECTOR_SIMD_NEON)
+    for (; i + 16 <= size; i += 16) {
+        if (vminvq_u8(vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i))) != 0xFF) {
+            break;  // различие внутри этого блока ищет скалярный цикл
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (a[i] != b[i]) {
+            return i;
+        }
+    }
+    return size;
+}
+
+// Индекс первой пары элементов, для которых !(a == b) (Ordered == false)
+// или a < b || b < a (Ordered == true), либо size
+template <bool Ordered>
+size_t MismatchFloat(const float* a, const float* b, size_t size) noexcept {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 8 <= size; i += 8) {
+        constexpr int kPredicate = Ordered ? _CMP_NEQ_OQ : _CMP_NEQ_UQ;
+        const __m256 differ = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), kPredicate);
+        if (const int mask = _mm256_movemask_ps(differ); mask != 0) {
+            return i + CountTrailingZeros(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+    for (; i + 4 <= size; i += 4) {
+        const __m128 x = _mm_loadu_ps(a + i);
+        const __m128 y = _mm_loadu_ps(b + i);
+        __m128 differ;
+        if constexpr (Ordered) {
+            differ = _mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmpgt_ps(x, y));
+        } else {
+            differ = _mm_cmpneq_ps(x, y);
+        }
+        if (const int mask = _mm_movemask_ps(differ); mask != 0) {
+            return i + CountTrailingZeros(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (Ordered ? (a[i] < b[i] || b[i] < a[i]) : !(a[i] == b[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+template <bool Ordered>
+size_t MismatchFloat(const double* a, const double* b, size_t size) noexcept {
+    size_t i = 0;
+#if defined(__AVX__)
+    for (; i + 4 <= size; i += 4) {
+        constexpr int kPredicate = Ordered ? _CMP_NEQ_OQ : _CMP_NEQ_UQ;
+        const __m256d differ = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), kPredicate);
+        if (const int mask = _mm256_movemask_pd(differ); mask != 0) {
+            return i + CountTrailingZeros(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+#if defined(SIMPLE_VECTOR_SIMD_X86)
+    for (; i + 2 <= size; i += 2) {
+        const __m128d x = _mm_loadu_pd(a + i);
+        const __m128d y = _mm_loadu_pd(b + i);
+        __m128d differ;
+        if constexpr (Ordered) {
+            differ = _mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmpgt_pd(x, y));
+        } else {
+            differ = _mm_cmpneq_pd(x, y);
+        }
+        if (const int mask = _mm_movemask_pd(differ); mask != 0) {
+            return i + CountTrailingZeros(static_cast<unsigned>(mask));
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (Ordered ? (a[i] < b[i] || b[i] < a[i]) : !(a[i] == b[i])) {
+            return i;
+        }
+    }
+    return size;
+}
+
+template <typename Type>
+constexpr bool kIsFloat = std::is_same_v<Type, float> || std::is_same_v<Type, double>;
+
+}  // namespace simd_detail
+
+// Индекс первого элемента, на котором a и b различаются в смысле Ordered (см. MismatchFloat),
+// либо size
+template <bool Ordered, typename Type>
+size_t MismatchIndex(const Type* a, const Type* b, size_t size) {
+    if constexpr (std::is_integral_v<Type>) {
+        return simd_detail::MismatchBytes(reinterpret_cast<const unsigned char*>(a),
+                                          reinterpret_cast<const unsigned char*>(b), size * sizeof(Type))
+               / sizeof(Type);
+    } else if constexpr (simd_detail::kIsFloat<Type>) {
+        return simd_detail::MismatchFloat<Ordered>(a, b, size);
+    } else if constexpr (Ordered) {
+        return std::mismatch(a, a + size, b, [](const Type& x, const Type& y) {
+                   return !(x < y || y < x);
+               }).first - a;
+    } else {
+        return std::mismatch(a, a + size, b).first - a;
+    }
+}
+
+// То же, что std::equal(a, a + size, b)
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR bool ElementsEqual(const Type* a, const Type* b, size_t size) {
+    if (size == 0) {
+        return true;
+    }
+    if (simple_vector_detail::IsConstantEvaluated()) {
+        return std::equal(a, a + size, b);
+    }
+    if constexpr (std::is_integral_v<Type>) {
+        return std::memcmp(a, b, size * sizeof(Type)) == 0;
+    } else if constexpr (simd_detail::kIsFloat<Type>) {
+        return MismatchIndex<false>(a, b, size) == size;
+    } else {
+        return std::equal(a, a + size, b);
+    }
+}
+
+// То же, что std::lexicographical_compare(a, a + a_size, b, b + b_size)
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR bool LexicographicalLess(const Type* a, size_t a_size, const Type* b, size_t b_size) {
+    if (simple_vector_detail::IsConstantEvaluated()) {
+        return std::lexicographical_compare(a, a + a_size, b, b + b_size);
+    }
+    if constexpr (std::is_integral_v<Type> || simd_detail::kIsFloat<Type>) {
+        const size_t common = std::min(a_size, b_size);
+        const size_t mismatch = common == 0 ? 0 : MismatchIndex<true>(a, b, common);
+        return mismatch < common ? a[mismatch] < b[mismatch] : a_size < b_size;
+    } else {
+        return std::lexicographical_compare(a, a + a_size, b, b + b_size);
+    }
+}
@@ -1,124 +1,262 @@
 #pragma once
 #include "array_ptr.h"
+#include "constexpr_support.h"
+#include "growth_policy.h"
+#include "hardening.h"
+#include "parallel.h"
+#include "simd_compare.h"
+#include "simple_vector_view.h"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <stdexcept>
 #include <cassert>
+#include <iterator>
+#include <type_traits>
 #include <utility>
 
 struct ReserveProxyObj {
     size_t capacity;
 };
 
-ReserveProxyObj Reserve(size_t capacity_to_reserve) {
+constexpr ReserveProxyObj Reserve(size_t capacity_to_reserve) {
     return ReserveProxyObj{capacity_to_reserve};
 }
 
+// Признак того, что объект Type можно переместить в другое место памяти побайтовым копированием,
+// а исходную память считать неинициализированной, не вызывая конструктор перемещения и деструктор.
+// Верно для тривиально копируемых типов; для остальных его можно специализировать вручную
+// (например, для типов, хранящих только std::unique_ptr)
 template <typename Type>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<Type> {};
+
+// Буфер, отданный вектором через ReleaseBuffer: первые size из capacity элементов живы.
+// Память выделена аллокатором вектора, и владелец должен сам уничтожить элементы и вернуть её
+// (или передать буфер обратно через SimpleVector::Adopt)
+template <typename Type>
+struct ReleasedBuffer {
+    Type* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+// Разрешает перегрузку только для итераторов, чтобы Insert(pos, count, value)
+// с целыми аргументами не принимался за вставку диапазона
+template <typename It>
+using RequireInputIterator = std::enable_if_t<std::is_convertible_v<
+        typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+// Память выделяется через Alloc, элементы создаются и уничтожаются
+// через std::allocator_traits<Alloc>, поэтому подходят и std::pmr::polymorphic_allocator,
+// и пользовательские пулы. Growth задаёт, как растёт вместимость при переполнении
+// (см. growth_policy.h).
+// С макросом SIMPLE_VECTOR_STATS вектор ведёт счётчики выделений и перемещений
+// (см. simple_vector_stats.h).
+// В C++20 с аллокатором std::allocator вектор можно строить и менять в константных вычислениях,
+// но память, выделенная в них, должна быть освобождена до их конца (см. constexpr_support.h).
+// Проверки индексов и итераторов настраиваются макросом SIMPLE_VECTOR_HARDENING (см. hardening.h)
+// При переносе элементов в новый буфер они перемещаются, только если конструктор перемещения
+// не бросает исключений (или Type некопируем), иначе копируются, как std::move_if_noexcept.
+// Поэтому рост даёт строгую гарантию: если при нём выброшено исключение, вектор не меняется
+template <typename Type, typename Alloc = std::allocator<Type>, typename Growth = DoublingGrowth>
 class SimpleVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    // Тривиально перемещаемые элементы сдвигаются через memmove, а при аллокаторе
+    // с reallocate буфер растёт через realloc
+    static constexpr bool kRelocatable = IsTriviallyRelocatable<Type>::value;
+    static constexpr bool kReallocInPlace = kRelocatable && HasReallocate<Alloc>::value;
+
+#if SIMPLE_VECTOR_HARDENING >= 2
+    template <typename, typename>
+    friend class CheckedIterator;
+
+public:
+    using Iterator = CheckedIterator<Type, SimpleVector>;
+    using ConstIterator = CheckedIterator<const Type, SimpleVector>;
+#else
 public:
     using Iterator = Type*;
     using ConstIterator = const Type*;
-    using ItemsPtr = ArrayPtr<Type>;
+#endif
+    using ItemsPtr = ArrayPtr<Type, Alloc>;
+    using AllocatorType = Alloc;
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector() = default;
 
-    SimpleVector() noexcept = default;
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(const Alloc& alloc) noexcept
+        : items_(alloc){
+    }
 
     // Создаёт вектор из size элементов, инициализированных значением по умолчанию
-    explicit SimpleVector(size_t size)
-        :SimpleVector(size, Type{}){
+    SIMPLE_VECTOR_CONSTEXPR explicit SimpleVector(size_t size, const Alloc& alloc = Alloc())
+        : items_(size, alloc){
+        UninitializedValueConstruct(items_.Get(), items_.Get() + size);
+        size_ = size;
     }
 
     // Создаёт вектор из size элементов, инициализированных значением value
-    SimpleVector(size_t size, const Type& value) 
-        : items_(size)
-        , size_(size)
-        , capacity_(size){
-        std::fill(items_.Get(), items_.Get() + size_, value);
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(size_t size, const Type& value, const Alloc& alloc = Alloc()) 
+        : items_(size, alloc){
+        UninitializedFill(items_.Get(), items_.Get() + size, value);
+        size_ = size;
     }
 
     // Создаёт вектор из std::initializer_list
-    SimpleVector(std::initializer_list<Type> init) 
-        : items_(init.size())
-        , size_(init.size())
-        , capacity_(init.size()){
-        std::copy(init.begin(), init.end(), items_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(std::initializer_list<Type> init, const Alloc& alloc = Alloc()) 
+        : items_(init.size(), alloc){
+        UninitializedCopy(init.begin(), init.end(), items_.Get());
+        size_ = init.size();
     }
 
-    SimpleVector(ReserveProxyObj reserved)
-            : items_(reserved.capacity)
-            , size_(0)
-            , capacity_(reserved.capacity) {
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(ReserveProxyObj reserved, const Alloc& alloc = Alloc())
+            : items_(reserved.capacity, alloc) {
+        RecordIdleCapacity();
     }
     
-    SimpleVector(const SimpleVector& other) 
-        : items_(other.size_)
-        , size_(other.size_)
-        , capacity_(other.size_){
-        std::copy(other.items_.Get(), other.items_.Get() + size_, items_.Get());
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other) 
+        : SimpleVector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator())){
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(const SimpleVector& other, const Alloc& alloc) 
+        : items_(other.size_, alloc){
+        UninitializedCopy(other.Data(), other.DataEnd(), items_.Get());
+        size_ = other.size_;
+    }
+
+    // Параллельные варианты конструкторов (см. parallel.h). Каждый поток конструирует
+    // свой непрерывный кусок, поэтому Alloc::construct должен допускать вызов из нескольких потоков
+
+    SimpleVector(const ParallelExecution& policy, size_t size, const Type& value, const Alloc& alloc = Alloc())
+        : items_(size, alloc){
+        ParallelConstruct(policy, items_.Get(), size, [this, &value](Type* first, Type* last) {
+            UninitializedFill(first, last, value);
+        });
+        size_ = size;
+    }
+
+    SimpleVector(const ParallelExecution& policy, const SimpleVector& other)
+        : items_(other.size_, AllocTraits::select_on_container_copy_construction(other.GetAllocator())){
+        const Type* source = other.Data();
+        Type* dest = items_.Get();
+        ParallelConstruct(policy, dest, other.size_, [this, source, dest](Type* first, Type* last) {
+            UninitializedCopy(source + (first - dest), source + (last - dest), first);
+        });
+        size_ = other.size_;
     }
     
-    SimpleVector(SimpleVector&& other) 
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector(SimpleVector&& other) noexcept
         : items_(std::move(other.items_)){
         size_ = std::exchange(other.size_, 0);
-        capacity_ = std::exchange(other.capacity_, 0);
+        other.InvalidateIterators();
+    }
+
+    // Уничтожает живые элементы [0, size_); память освобождает ArrayPtr
+    SIMPLE_VECTOR_CONSTEXPR ~SimpleVector() {
+        Destroy(Data(), DataEnd());
     }
 
-    SimpleVector& operator=(const SimpleVector& rhs) {
+    // Строгая гарантия: копия строится до того, как this изменится
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(const SimpleVector& rhs) {
         if (&rhs != this){
-            if (rhs.IsEmpty())
-                Clear(); 
-                
-            auto rhs_copy(rhs);
-                swap(rhs_copy);
+            SimpleVector rhs_copy(rhs, AllocTraits::propagate_on_container_copy_assignment::value
+                                           ? rhs.GetAllocator() : GetAllocator());
+            swap(rhs_copy);
         }
         return *this;
     }
 
-    SimpleVector& operator=(SimpleVector&& rhs){
-		items_ = std::move(rhs.items_);
-        size_ = std::exchange(rhs.size_, 0);
-        capacity_ = std::exchange(rhs.capacity_, 0);
+    // Если аллокатор не распространяется при перемещении и не равен аллокатору rhs,
+    // буфер rhs забрать нельзя, и элементы перемещаются поштучно в память this.
+    // В остальных случаях присваивание не бросает исключений
+    SIMPLE_VECTOR_CONSTEXPR SimpleVector& operator=(SimpleVector&& rhs) noexcept(
+            AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value){
+        if (&rhs != this){
+            if (AllocTraits::propagate_on_container_move_assignment::value
+                || GetAllocator() == rhs.GetAllocator()) {
+                Clear();
+                items_ = std::move(rhs.items_);
+                InvalidateIterators();
+                rhs.InvalidateIterators();
+                size_ = std::exchange(rhs.size_, 0);
+            } else {
+                SimpleVector rhs_moved(::Reserve(rhs.size_), GetAllocator());
+                UninitializedMove(rhs.Data(), rhs.DataEnd(), rhs_moved.items_.Get());
+                rhs_moved.size_ = rhs.size_;
+                swap(rhs_moved);
+                rhs.Clear();
+            }
+        }
         return *this;
 	}
     
-    void Reserve(size_t new_capacity){
-        if (capacity_ < new_capacity){
-            auto new_items = ReallocateCopy(new_capacity);
-            items_.swap(new_items);
-            capacity_ = new_capacity;
+    // Строгая гарантия
+    SIMPLE_VECTOR_CONSTEXPR void Reserve(size_t new_capacity){
+        if (GetCapacity() < new_capacity){
+            ReallocateCopy(new_capacity);
+            RecordIdleCapacity();
         }
     }
 
+    // Уменьшает вместимость до размера, перенося элементы в буфер точно по размеру
+    // (для тривиально перемещаемых — одним memcpy или realloc). Пустой вектор освобождает буфер целиком.
+    // Строгая гарантия
+    SIMPLE_VECTOR_CONSTEXPR void ShrinkToFit() {
+        if (size_ == GetCapacity()) {
+            return;
+        }
+        if (size_ == 0) {
+            items_ = ItemsPtr(items_.GetAllocator());
+            InvalidateIterators();
+        } else {
+            ReallocateCopy(size_);
+        }
+    }
+
+    // Уничтожает все элементы и освобождает буфер
+    SIMPLE_VECTOR_CONSTEXPR void ClearAndRelease() noexcept {
+        Clear();
+        items_ = ItemsPtr(items_.GetAllocator());
+        InvalidateIterators();
+    }
+
+    // Возвращает копию аллокатора вектора
+    SIMPLE_VECTOR_CONSTEXPR Alloc GetAllocator() const noexcept {
+        return items_.GetAllocator();
+    }
+
     // Возвращает количество элементов в массиве
-    size_t GetSize() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR size_t GetSize() const noexcept {
         return size_;
     }
 
     // Возвращает вместимость массива
-    size_t GetCapacity() const noexcept {
-        return capacity_;
+    SIMPLE_VECTOR_CONSTEXPR size_t GetCapacity() const noexcept {
+        return items_.GetSize();
     }
 
     // Сообщает, пустой ли массив
-    bool IsEmpty() const noexcept {
+    SIMPLE_VECTOR_CONSTEXPR bool IsEmpty() const noexcept {
         return size_ == 0;
     }
 
     // Возвращает ссылку на элемент с индексом index
-    Type& operator[](size_t index) noexcept {
-        assert(index < size_);
+    SIMPLE_VECTOR_CONSTEXPR Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
-    const Type& operator[](size_t index) const noexcept {
-        assert(index < size_);
+    SIMPLE_VECTOR_CONSTEXPR const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
         return items_[index];
     }
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    Type& At(size_t index) {
+    SIMPLE_VECTOR_CONSTEXPR Type& At(size_t index) {
         if (index >= size_) 
             throw std::out_of_range{"index >= size"};
         return items_[index];
@@ -126,205 +264,921 @@ public:
 
     // Возвращает константную ссылку на элемент с индексом index
     // Выбрасывает исключение std::out_of_range, если index >= size
-    const Type& At(size_t index) const {
+    SIMPLE_VECTOR_CONSTEXPR const Type& At(size_t index) const {
         if (index >= size_) 
             throw std::out_of_range{"index >= size"};
         return items_[index];
     }
 
-    // Обнуляет размер массива, не изменяя его вместимость
-    void Clear() noexcept {
+    // Уничтожает все элементы, не изменяя вместимость массива
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        Destroy(Data(), DataEnd());
         size_ = 0;
+        RecordIdleCapacity();
     }
 
     // Изменяет размер массива.
-    // При увеличении размера новые элементы получают значение по умолчанию для типа Type
-    void Resize(size_t new_size) {
-        
-        if (new_size > capacity_){
-            const size_t new_capacity = std::max(capacity_ * 2, new_size);
-            auto new_items = ReallocateCopy(new_capacity);
-            std::fill(new_items.Get() + size_, new_items.Get() + new_size, Type{});
-            items_.swap(new_items);
-            capacity_ = new_capacity;
-        } else
-            if (new_size > size_){
-                std::fill(items_.Get() + size_, items_.Get() + new_size, Type{});
-            }
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type,
+    // при уменьшении лишние элементы уничтожаются.
+    // Строгая гарантия для содержимого: если конструктор нового элемента бросит исключение,
+    // элементы и размер останутся прежними, хотя вместимость уже может вырасти
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= size_){
+            Destroy(Data() + new_size, DataEnd());
+            size_ = new_size;
+            RecordIdleCapacity();
+            return;
+        }
+        if (new_size > GetCapacity()){
+            ReallocateCopy(NextCapacity(new_size));
+        }
+        UninitializedValueConstruct(DataEnd(), Data() + new_size);
         size_ = new_size;
+        RecordIdleCapacity();
     }
 
-    // Возвращает итератор на начало массива
+    // Resize, в котором новые элементы конструируются параллельно
+    void Resize(const ParallelExecution& policy, size_t new_size) {
+        if (new_size <= size_){
+            Resize(new_size);
+            return;
+        }
+        if (new_size > GetCapacity()){
+            ReallocateCopy(NextCapacity(new_size));
+        }
+        ParallelConstruct(policy, DataEnd(), new_size - size_, [this](Type* first, Type* last) {
+            UninitializedValueConstruct(first, last);
+        });
+        size_ = new_size;
+        RecordIdleCapacity();
+    }
+
+    // Как Resize, но новые элементы инициализируются по умолчанию, а не значением:
+    // для тривиальных типов (int, POD-структур) память не заполняется нулями и остаётся
+    // неопределённой, пока её не перезапишут. Нетривиальные элементы создаются через Alloc::construct,
+    // так что, например, pmr-строки получают ресурс вектора
+    void ResizeDefaultInit(size_t new_size) {
+        if (new_size <= size_){
+            Destroy(Data() + new_size, DataEnd());
+            size_ = new_size;
+            RecordIdleCapacity();
+            return;
+        }
+        if (new_size > GetCapacity()){
+            ReallocateCopy(NextCapacity(new_size));
+        }
+        UninitializedDefaultConstruct(DataEnd(), Data() + new_size);
+        size_ = new_size;
+        RecordIdleCapacity();
+    }
+
+    // Увеличивает размер до count, инициализируя новые элементы по умолчанию, и передаёт
+    // буфер в op(Type* data, size_t count), которая заполняет его и возвращает итоговый размер
+    // не больше count. Элементы за этим размером уничтожаются. Подходит для чтения
+    // из сокета или файла прямо в вектор без предварительного заполнения нулями
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t count, Operation op) {
+        ResizeDefaultInit(std::max(count, size_));
+        const size_t new_size = std::move(op)(Data(), count);
+        SIMPLE_VECTOR_CHECK(new_size <= count, "ResizeAndOverwrite operation returned too large size");
+        Destroy(Data() + new_size, DataEnd());
+        size_ = new_size;
+        RecordIdleCapacity();
+    }
+
+    // Возвращает указатель на первый элемент, например для memcpy или системного вызова.
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator begin() noexcept {
+    SIMPLE_VECTOR_CONSTEXPR Type* Data() noexcept {
+        return items_.Get();
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* Data() const noexcept {
         return items_.Get();
     }
 
+    // Возвращает итератор на начало массива
+    // Для пустого массива может быть равен (или не равен) nullptr
+    SIMPLE_VECTOR_CONSTEXPR Iterator begin() noexcept {
+        return IteratorAt(0);
+    }
+
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    Iterator end() noexcept {
-        return items_.Get()+size_;
+    SIMPLE_VECTOR_CONSTEXPR Iterator end() noexcept {
+        return IteratorAt(size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator begin() const noexcept {
-        return items_.Get();
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator begin() const noexcept {
+        return IteratorAt(0);
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator end() const noexcept {
-        return items_.Get()+size_;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator end() const noexcept {
+        return IteratorAt(size_);
     }
 
     // Возвращает константный итератор на начало массива
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cbegin() const noexcept {
-        return items_.Get();
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cbegin() const noexcept {
+        return IteratorAt(0);
     }
 
     // Возвращает итератор на элемент, следующий за последним
     // Для пустого массива может быть равен (или не равен) nullptr
-    ConstIterator cend() const noexcept {
-        return items_.Get()+size_;
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator cend() const noexcept {
+        return IteratorAt(size_);
     }
     
     // Добавляет элемент в конец вектора
     // При нехватке места увеличивает вдвое вместимость вектора
-    void PushBack(const Type& item) {
-        size_t new_size = size_ + 1;
-        if (capacity_ < new_size){
-            capacity_ = std::max(capacity_*2, new_size);
-            auto new_items = ReallocateCopy(capacity_);
-            new_items.Get()[size_] = item;
-            items_.swap(new_items);
-        } else{
-            items_.Get()[size_] = item;
-            }
-        size_ = new_size;
+    // Строгая гарантия
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
     }
     
-    void PushBack(Type && item){
-        size_t new_size = size_ + 1;
-        if (capacity_ < new_size){
-            capacity_ = std::max(capacity_*2, new_size);
-            auto new_items = ReallocateCopy(capacity_);
-            new_items.Get()[size_] = std::move(item);
-            items_.swap(new_items);
-        } else {
-            items_.Get()[size_] = std::move(item);
-            }
-        size_ = new_size;
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type && item){
+        EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args прямо в конце вектора и возвращает ссылку на него
+    // При нехватке места увеличивает вдвое вместимость вектора
+    // Строгая гарантия
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        if (size_ < GetCapacity()) {
+            Type* item = DataEnd();
+            Construct(item, std::forward<Args>(args)...);
+            ++size_;
+            return *item;
+        }
+        return *Emplace(cend(), std::forward<Args>(args)...);
     }
 
     // Вставляет значение value в позицию pos.
     // Возвращает итератор на вставленное значение
     // Если перед вставкой значения вектор был заполнен полностью,
     // вместимость вектора должна увеличиться вдвое, а для вектора вместимостью 0 стать равной 1
-    Iterator Insert(ConstIterator pos, const Type& value) {
-        assert(begin() <= pos && pos <= end());
-        size_t new_pos = pos - cbegin();
-        size_t new_size = size_ + 1;
-        if (new_size <= capacity_) {
-            Iterator change_pos = begin() + new_pos;
-            std::copy_backward(pos, cend(), end() + 1);
-            *change_pos = value;
-        } else {
-            capacity_ = std::max(capacity_ * 2, new_size);
-            ItemsPtr items(capacity_);
-            Iterator items_pos = items.Get() + new_pos;
-            std::copy(cbegin(), pos, items.Get());
-            *items_pos = value;
-            std::copy(pos, cend(), items_pos+1);
-            items_.swap(items);
-        }            
-        size_ = new_size;
-        return begin() + new_pos;
+    // Гарантии те же, что у Emplace
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
     }
     
-    Iterator Insert(ConstIterator pos, Type&& value){
-        assert(begin() <= pos && pos <= end());
-        size_t new_pos = pos - cbegin();
-        size_t new_size = size_ + 1;
-        Iterator change_pos = begin() + new_pos;
-        if (new_size <= capacity_){
-            std::move_backward(change_pos, end(), end() + 1);
-            *change_pos = std::move(value);
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value){
+        return Emplace(pos, std::move(value));
+    }
+
+    // Конструирует элемент из args в позиции pos и возвращает итератор на него.
+    // При переполнении вместимость растёт так же, как в Insert, а стратегия
+    // с kTryExpandInPlace сначала пробует расширить буфер на месте.
+    // Без реаллокации и не в конце элемент сначала создаётся во временном объекте,
+    // так как args могут ссылаться на элементы самого вектора.
+    // Строгая гарантия при вставке в конец, при реаллокации, для тривиально перемещаемых Type
+    // и для Type с небросающим перемещением. Иначе при исключении из перемещения
+    // во время сдвига хвоста — только базовая гарантия, как у std::vector
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        const size_t index = IndexOf(pos);
+        if (size_ == GetCapacity()) {
+            TryGrowInPlace(NextCapacity(size_ + 1));
+        }
+        if (size_ < GetCapacity()) {
+            if (index == size_) {
+                Construct(DataEnd(), std::forward<Args>(args)...);
+            } else if constexpr (kRelocatable) {
+                ShiftAndConstruct(index, Type(std::forward<Args>(args)...));
+                return IteratorAt(index);
+            } else {
+                Type tmp(std::forward<Args>(args)...);
+                simple_vector_stats::RecordShifted<Type>(size_ - index);
+                Construct(DataEnd(), std::move(*(DataEnd() - 1)));
+                // новый последний элемент уже живой: если сдвиг бросит, его уничтожит деструктор
+                ++size_;
+                std::move_backward(Data() + index, DataEnd() - 2, DataEnd() - 1);
+                items_[index] = std::move(tmp);
+                return IteratorAt(index);
+            }
+        } else if constexpr (kReallocInPlace) {
+            // realloc может освободить память, на которую ссылаются args
+            Type tmp(std::forward<Args>(args)...);
+            items_.Reallocate(NextCapacity(size_ + 1));
+            InvalidateIterators();
+            simple_vector_stats::RecordRelocated<Type>(size_);
+            ShiftAndConstruct(index, std::move(tmp));
+            RecordIdleCapacity();
+            return IteratorAt(index);
         } else {
-            capacity_ = std::max(capacity_ * 2, new_size);
-            ItemsPtr items(capacity_);
-            Iterator items_pos = items.Get() + new_pos;
-            std::move(begin(), change_pos, items.Get());
-            *items_pos = std::move(value);
-            std::move(change_pos, end(), items_pos + 1);
-            items_.swap(items);
+            const size_t new_capacity = NextCapacity(size_ + 1);
+            ItemsPtr new_items(new_capacity, items_.GetAllocator());
+            Type* new_pos = new_items.Get() + index;
+            Construct(new_pos, std::forward<Args>(args)...);
+            try {
+                RelocateAround(new_items.Get(), index, 1);
+            } catch (...) {
+                Destroy(new_pos, new_pos + 1);
+                throw;
+            }
+            items_.swap(new_items);
+            InvalidateIterators();
+            RecordIdleCapacity();
         }
-        size_ = new_size;
-        return begin() + new_pos;
+        ++size_;
+        return IteratorAt(index);
     }
 
-    // "Удаляет" последний элемент вектора. Вектор не должен быть пустым
-    void PopBack() noexcept {
-        assert(!IsEmpty());
-        size_--;
+    // Вставляет копии элементов [first, last) перед pos и возвращает итератор на первый из них.
+    // Для однопроходных итераторов элементы добавляются в конец и поворачиваются на место.
+    // Иначе размер считается один раз: буфер выделяется не более одного раза,
+    // а хвост сдвигается ровно один раз. Диапазон не должен указывать в сам вектор.
+    // Строгая гарантия при реаллокации и для тривиально перемещаемых Type, иначе базовая
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, InputIt first, InputIt last) {
+        const size_t index = IndexOf(pos);
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            return InsertN(index, first, static_cast<size_t>(std::distance(first, last)));
+        } else {
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(Data() + index, Data() + old_size, DataEnd());
+            return IteratorAt(index);
+        }
     }
 
-    // Удаляет элемент вектора в указанной позиции
-    Iterator Erase(ConstIterator pos) {
-        assert(begin() <= pos && pos < end());
-        Iterator change_pos = begin() + (pos - cbegin());
-        std::move(change_pos + 1, end(), change_pos);
+    // Вставляет count копий value перед pos и возвращает итератор на первую из них.
+    // value может ссылаться на элемент самого вектора
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, size_t count, const Type& value) {
+        const size_t index = IndexOf(pos);
+        if (count == 0) {
+            return IteratorAt(index);
+        }
+        const Type tmp(value);
+        return InsertN(index, Repeat{&tmp}, count);
+    }
+
+    // Добавляет копии элементов [first, last) в конец вектора
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR void Append(InputIt first, InputIt last) {
+        Insert(cend(), first, last);
+    }
+
+    // Заменяет содержимое вектора копиями элементов [first, last).
+    // Если они помещаются в текущую вместимость, память не выделяется, а существующие
+    // элементы переприсваиваются. Иначе новый буфер выделяется один раз ровно под диапазон
+    // со строгой гарантией
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    SIMPLE_VECTOR_CONSTEXPR void Assign(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const size_t count = std::distance(first, last);
+            if (count > GetCapacity()) {
+                SimpleVector assigned(::Reserve(count), GetAllocator());
+                UninitializedCopy(first, last, assigned.Data());
+                assigned.size_ = count;
+                swap(assigned);
+                return;
+            }
+            const size_t common = std::min(count, size_);
+            for (Type* current = Data(); current != Data() + common; ++current, ++first) {
+                *current = *first;
+            }
+            if (count < size_) {
+                Destroy(Data() + count, DataEnd());
+            } else {
+                UninitializedCopy(first, last, DataEnd());
+            }
+            size_ = count;
+        } else {
+            Clear();
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    // Уничтожает последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(!IsEmpty(), "PopBack on empty vector");
         --size_;
-        return change_pos;
+        Destroy(DataEnd(), DataEnd() + 1);
+        RecordIdleCapacity();
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    // Не бросает исключений, если их не бросает перемещающее присваивание Type
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        const size_t index = IndexOf(pos);
+        SIMPLE_VECTOR_CHECK(index < size_, "erase position out of range");
+        Type* change_pos = Data() + index;
+        simple_vector_stats::RecordShifted<Type>(DataEnd() - change_pos - 1);
+        if constexpr (kRelocatable) {
+            Destroy(change_pos, change_pos + 1);
+            RelocateBitwise(change_pos + 1, DataEnd(), change_pos);
+            --size_;
+            RecordIdleCapacity();
+        } else {
+            std::move(change_pos + 1, DataEnd(), change_pos);
+            PopBack();
+        }
+        return IteratorAt(index);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз, и возвращает итератор
+    // на элемент, следовавший за удалёнными
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        const size_t first_index = IndexOf(first);
+        const size_t last_index = IndexOf(last);
+        SIMPLE_VECTOR_CHECK(first_index <= last_index, "erase range is reversed");
+        Type* erase_first = Data() + first_index;
+        Type* erase_last = Data() + last_index;
+        const size_t count = erase_last - erase_first;
+        simple_vector_stats::RecordShifted<Type>(DataEnd() - erase_last);
+        if constexpr (kRelocatable) {
+            Destroy(erase_first, erase_last);
+            RelocateBitwise(erase_last, DataEnd(), erase_first);
+        } else {
+            std::move(erase_last, DataEnd(), erase_first);
+            Destroy(DataEnd() - count, DataEnd());
+        }
+        size_ -= count;
+        RecordIdleCapacity();
+        return IteratorAt(first_index);
+    }
+
+    // Удаляет элемент в позиции pos за O(1), перенося на его место последний элемент.
+    // Порядок остальных элементов не сохраняется. Возвращает итератор на позицию pos
+    SIMPLE_VECTOR_CONSTEXPR Iterator UnorderedErase(ConstIterator pos) {
+        const size_t index = IndexOf(pos);
+        SIMPLE_VECTOR_CHECK(index < size_, "erase position out of range");
+        Type* change_pos = Data() + index;
+        Type* last = DataEnd() - 1;
+        if constexpr (kRelocatable) {
+            Destroy(change_pos, change_pos + 1);
+            if (change_pos != last) {
+                RelocateBitwise(last, DataEnd(), change_pos);
+            }
+            --size_;
+            RecordIdleCapacity();
+        } else {
+            if (change_pos != last) {
+                *change_pos = std::move(*last);
+            }
+            PopBack();
+        }
+        return IteratorAt(index);
+    }
+
+    // Удаляет все элементы, для которых pred истинно, за один проход с сохранением порядка
+    // и возвращает их число. Тривиально перемещаемые элементы сдвигаются непрерывными
+    // отрезками через memmove, остальные — перемещающим присваиванием, а освободившийся хвост
+    // уничтожается один раз. Базовая гарантия: если pred бросает исключение, вектор остаётся
+    // корректным, но часть элементов может быть удалена или перемещена
+    template <typename Pred>
+    SIMPLE_VECTOR_CONSTEXPR size_t EraseIf(Pred pred) {
+        Type* first_erased = std::find_if(Data(), DataEnd(), [&pred](const Type& item) {
+            return pred(item);
+        });
+        if (first_erased == DataEnd()) {
+            return 0;
+        }
+        const size_t old_size = size_;
+        Type* write = first_erased;
+        if constexpr (kRelocatable) {
+            Type* const last = DataEnd();
+            Destroy(write, write + 1);
+            // [kept, read) — оставляемые элементы, ещё не перенесённые на место write
+            Type* read = write + 1;
+            Type* kept = read;
+            try {
+                for (; read != last; ++read) {
+                    if (pred(std::as_const(*read))) {
+                        RelocateBitwise(kept, read, write);
+                        write += read - kept;
+                        Destroy(read, read + 1);
+                        kept = read + 1;
+                    }
+                }
+            } catch (...) {
+                RelocateBitwise(kept, last, write);
+                size_ = (write - Data()) + (last - kept);
+                throw;
+            }
+            RelocateBitwise(kept, last, write);
+            write += last - kept;
+        } else {
+            for (Type* read = write + 1; read != DataEnd(); ++read) {
+                if (!pred(std::as_const(*read))) {
+                    *write = std::move(*read);
+                    ++write;
+                }
+            }
+            Destroy(write, DataEnd());
+        }
+        simple_vector_stats::RecordShifted<Type>(write - first_erased);
+        size_ = write - Data();
+        RecordIdleCapacity();
+        return old_size - size_;
+    }
+
+    // Удаляет все элементы, равные value, и возвращает их число (см. EraseIf)
+    SIMPLE_VECTOR_CONSTEXPR size_t Remove(const Type& value) {
+        if (Data() <= &value && &value < DataEnd()) {
+            // value лежит в векторе и может быть уничтожен по ходу удаления
+            const Type copy = value;
+            return Remove(copy);
+        }
+        return EraseIf([&value](const Type& item) {
+            return item == value;
+        });
+    }
+
+    // Удаляет элементы с индексами из sorted_indices, упорядоченными по возрастанию без повторов,
+    // сдвигая каждый оставшийся элемент не больше одного раза
+    void EraseIndices(SimpleVectorConstView<size_t> sorted_indices) {
+        if (sorted_indices.IsEmpty()) {
+            return;
+        }
+        SIMPLE_VECTOR_CHECK(std::adjacent_find(sorted_indices.begin(), sorted_indices.end(), std::greater_equal<>())
+                                    == sorted_indices.end(),
+                            "erased indices must be strictly increasing");
+        SIMPLE_VECTOR_CHECK(sorted_indices[sorted_indices.GetSize() - 1] < size_, "erased index out of range");
+        Type* write = Data() + sorted_indices[0];
+        for (size_t k = 0; k < sorted_indices.GetSize(); ++k) {
+            Type* erased = Data() + sorted_indices[k];
+            Type* next = k + 1 < sorted_indices.GetSize() ? Data() + sorted_indices[k + 1] : DataEnd();
+            if constexpr (kRelocatable) {
+                Destroy(erased, erased + 1);
+                RelocateBitwise(erased + 1, next, write);
+            } else {
+                std::move(erased + 1, next, write);
+            }
+            write += next - erased - 1;
+        }
+        simple_vector_stats::RecordShifted<Type>(DataEnd() - Data() - sorted_indices[0] - sorted_indices.GetSize());
+        if constexpr (!kRelocatable) {
+            Destroy(write, DataEnd());
+        }
+        size_ = write - Data();
+        RecordIdleCapacity();
+    }
+
+    // Забирает буфер items, в котором сконструированы первые size элементов, без копирования.
+    // Прежние элементы уничтожаются, прежний буфер освобождается.
+    // Как и при перемещении, аллокатор items должен быть равен аллокатору вектора,
+    // если он не распространяется при перемещающем присваивании
+    void Adopt(ItemsPtr&& items, size_t size) noexcept {
+        SIMPLE_VECTOR_CHECK(size <= items.GetSize(), "adopted size exceeds capacity");
+        Clear();
+        items_ = std::move(items);
+        InvalidateIterators();
+        size_ = size;
+    }
+
+    // Забирает буфер data вместимостью capacity, выделенный аллокатором, равным GetAllocator(),
+    // в котором сконструированы первые size элементов
+    void Adopt(Type* data, size_t size, size_t capacity) noexcept {
+        Adopt(ItemsPtr(data, capacity, items_.GetAllocator()), size);
+    }
+
+    // Отдаёт буфер вместе с живыми элементами без копирования и оставляет вектор пустым.
+    // Освобождать память нужно аллокатором, равным GetAllocator()
+    [[nodiscard]] ReleasedBuffer<Type> ReleaseBuffer() noexcept {
+        ReleasedBuffer<Type> buffer{items_.Get(), size_, GetCapacity()};
+        static_cast<void>(items_.Release());
+        InvalidateIterators();
+        size_ = 0;
+        return buffer;
     }
 
     // Обменивает значение с другим вектором
-    void swap(SimpleVector& other) noexcept {
+    SIMPLE_VECTOR_CONSTEXPR void swap(SimpleVector& other) noexcept {
         items_.swap(other.items_);
         std::swap(size_, other.size_);
-        std::swap(capacity_, other.capacity_);
+        InvalidateIterators();
+        other.InvalidateIterators();
     }
         
 private:
-    ItemsPtr ReallocateCopy(size_t new_capacity) const {
-        ItemsPtr new_items(new_capacity);
-        size_t copy_size = std::min(new_capacity, size_);
-        std::move(items_.Get(), items_.Get() + copy_size, new_items.Get());
-        return ItemsPtr(new_items.Release());
+    SIMPLE_VECTOR_CONSTEXPR Type* DataEnd() noexcept {
+        return items_.Get() + size_;
     }
-    
+
+    SIMPLE_VECTOR_CONSTEXPR const Type* DataEnd() const noexcept {
+        return items_.Get() + size_;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator IteratorAt(size_t index) noexcept {
+#if SIMPLE_VECTOR_HARDENING >= 2
+        return Iterator(items_.Get() + index, this);
+#else
+        return items_.Get() + index;
+#endif
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR ConstIterator IteratorAt(size_t index) const noexcept {
+#if SIMPLE_VECTOR_HARDENING >= 2
+        return ConstIterator(items_.Get() + index, this);
+#else
+        return items_.Get() + index;
+#endif
+    }
+
+    // Индекс позиции pos, которая должна указывать в [begin(), end()] этого вектора
+    SIMPLE_VECTOR_CONSTEXPR size_t IndexOf(ConstIterator pos) const noexcept {
+#if SIMPLE_VECTOR_HARDENING >= 2
+        pos.CheckPosition(this);
+        return pos.Get() - items_.Get();
+#else
+        SIMPLE_VECTOR_CHECK(cbegin() <= pos && pos <= cend(), "iterator out of range");
+        return pos - cbegin();
+#endif
+    }
+
+    // Отмечает, что буфер сменился и выданные раньше итераторы недействительны
+    SIMPLE_VECTOR_CONSTEXPR void InvalidateIterators() noexcept {
+#if SIMPLE_VECTOR_HARDENING >= 2
+        generation_ = simple_vector_detail::NextGeneration();
+#endif
+    }
+
+    // Переносит живые элементы в буфер вместимостью new_capacity и уничтожает их в старом.
+    // Тривиально перемещаемые элементы копируются одним memcpy или остаются на месте при realloc.
+    // Расширение на месте пробуется только при росте: при уменьшении память должна освободиться
+    SIMPLE_VECTOR_CONSTEXPR void ReallocateCopy(size_t new_capacity) {
+        assert(new_capacity >= size_);
+        if (new_capacity > GetCapacity() && TryGrowInPlace(new_capacity)) {
+            return;
+        }
+        simple_vector_stats::RecordRelocated<Type>(size_);
+        if constexpr (kReallocInPlace) {
+            items_.Reallocate(new_capacity);
+            InvalidateIterators();
+        } else {
+            ItemsPtr new_items(new_capacity, items_.GetAllocator());
+            if constexpr (kRelocatable) {
+                RelocateBitwise(Data(), DataEnd(), new_items.Get());
+            } else {
+                UninitializedMoveIfNoexcept(Data(), DataEnd(), new_items.Get());
+                Destroy(Data(), DataEnd());
+            }
+            items_.swap(new_items);
+            InvalidateIterators();
+        }
+    }
+
+    // Переносит элементы текущего буфера в new_data, оставляя между [0, index) и [index, size_)
+    // промежуток из gap позиций, и уничтожает их в старом буфере.
+    // При исключении всё созданное в new_data уничтожается, а текущий буфер не меняется
+    SIMPLE_VECTOR_CONSTEXPR void RelocateAround(Type* new_data, size_t index, size_t gap) {
+        simple_vector_stats::RecordRelocated<Type>(size_);
+        if constexpr (kRelocatable) {
+            RelocateBitwise(Data(), Data() + index, new_data);
+            RelocateBitwise(Data() + index, DataEnd(), new_data + index + gap);
+        } else {
+            UninitializedMoveIfNoexcept(Data(), Data() + index, new_data);
+            try {
+                UninitializedMoveIfNoexcept(Data() + index, DataEnd(), new_data + index + gap);
+            } catch (...) {
+                Destroy(new_data, new_data + index);
+                throw;
+            }
+            Destroy(Data(), DataEnd());
+        }
+    }
+
+    // Итератор, бесконечно повторяющий одно значение, для вставки count копий через InsertN
+    struct Repeat {
+        const Type* value;
+
+        SIMPLE_VECTOR_CONSTEXPR const Type& operator*() const noexcept {
+            return *value;
+        }
+        SIMPLE_VECTOR_CONSTEXPR Repeat& operator++() noexcept {
+            return *this;
+        }
+    };
+
+    // Вставляет count элементов, последовательно прочитанных из first, в позицию index
+    template <typename ForwardIt>
+    SIMPLE_VECTOR_CONSTEXPR Iterator InsertN(size_t index, ForwardIt first, size_t count) {
+        const size_t new_size = size_ + count;
+        if (count == 0) {
+            return IteratorAt(index);
+        }
+        if (new_size > GetCapacity()) {
+            TryGrowInPlace(NextCapacity(new_size));
+        }
+        if (new_size > GetCapacity()) {
+            ItemsPtr new_items(NextCapacity(new_size), items_.GetAllocator());
+            Type* gap = new_items.Get() + index;
+            UninitializedCopyN(first, count, gap);
+            try {
+                RelocateAround(new_items.Get(), index, count);
+            } catch (...) {
+                Destroy(gap, gap + count);
+                throw;
+            }
+            items_.swap(new_items);
+            InvalidateIterators();
+            size_ = new_size;
+            RecordIdleCapacity();
+            return IteratorAt(index);
+        }
+        simple_vector_stats::RecordShifted<Type>(size_ - index);
+        if constexpr (kRelocatable) {
+            Type* gap = Data() + index;
+            RelocateBitwise(gap, DataEnd(), gap + count);
+            try {
+                UninitializedCopyN(first, count, gap);
+            } catch (...) {
+                RelocateBitwise(gap + count, DataEnd() + count, gap);
+                throw;
+            }
+            size_ = new_size;
+        } else {
+            // Как в std::vector: часть хвоста переезжает в неинициализированную память,
+            // остальное сдвигается присваиванием, а новые значения присваиваются
+            // или конструируются в зависимости от того, попадают ли они в живые элементы
+            Type* gap = Data() + index;
+            Type* old_end = DataEnd();
+            const size_t elems_after = size_ - index;
+            if (elems_after > count) {
+                UninitializedMove(old_end - count, old_end, old_end);
+                size_ = new_size;
+                std::move_backward(gap, old_end - count, old_end);
+                for (Type* current = gap; current != gap + count; ++current, ++first) {
+                    *current = *first;
+                }
+            } else {
+                ForwardIt mid = first;
+                for (size_t i = 0; i < elems_after; ++i) {
+                    ++mid;
+                }
+                UninitializedCopyN(mid, count - elems_after, old_end);
+                size_ += count - elems_after;
+                UninitializedMove(gap, old_end, DataEnd());
+                size_ = new_size;
+                for (Type* current = gap; current != old_end; ++current, ++first) {
+                    *current = *first;
+                }
+            }
+        }
+        return IteratorAt(index);
+    }
+
+    // Конструирует [first, first + count) кусками в нескольких потоках вызовом construct(begin, end).
+    // Если какой-то кусок не удалось создать, уничтожаются и все остальные
+    template <typename ConstructChunk>
+    void ParallelConstruct(const ParallelExecution& policy, Type* first, size_t count, ConstructChunk construct) {
+        ParallelFor(policy, count, parallel_detail::PageGrid(first),
+                [first, &construct](size_t begin, size_t end) {
+                    construct(first + begin, first + end);
+                },
+                [this, first](size_t begin, size_t end) {
+                    Destroy(first + begin, first + end);
+                });
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void RecordIdleCapacity() const noexcept {
+        simple_vector_stats::RecordIdleCapacity<Type>(GetCapacity() - size_);
+    }
+
+    // Вместимость, до которой стратегия Growth растит полный вектор, чтобы вместить required элементов
+    SIMPLE_VECTOR_CONSTEXPR size_t NextCapacity(size_t required) const noexcept {
+        return Growth::template NextCapacity<Type>(GetCapacity(), required);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR bool TryGrowInPlace(size_t new_capacity) {
+        if constexpr (Growth::kTryExpandInPlace) {
+            return items_.TryExpand(new_capacity);
+        } else {
+            return false;
+        }
+    }
+
+    // Побайтово переносит [first, last) в dest; диапазоны могут перекрываться
+    static SIMPLE_VECTOR_CONSTEXPR void RelocateBitwise(Type* first, Type* last, Type* dest) noexcept {
+        static_assert(kRelocatable);
+        if (simple_vector_detail::IsConstantEvaluated()) {
+            RelocateThroughTemporary(first, last, dest);
+        } else if (first != last) {
+            std::memmove(static_cast<void*>(dest), static_cast<const void*>(first),
+                         (last - first) * sizeof(Type));
+        }
+    }
+
+    // RelocateBitwise в константных вычислениях, где memmove недоступен, а сравнивать указатели
+    // на разные буферы нельзя: элементы переезжают через временный буфер поштучным перемещением
+    static SIMPLE_VECTOR_CONSTEXPR void RelocateThroughTemporary(Type* first, Type* last, Type* dest) noexcept {
+        const size_t count = last - first;
+        if (count == 0) {
+            return;
+        }
+        std::allocator<Type> temp_alloc;
+        using TempTraits = std::allocator_traits<std::allocator<Type>>;
+        Type* temp = TempTraits::allocate(temp_alloc, count);
+        for (size_t i = 0; i < count; ++i) {
+            TempTraits::construct(temp_alloc, temp + i, std::move(first[i]));
+            TempTraits::destroy(temp_alloc, first + i);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            TempTraits::construct(temp_alloc, dest + i, std::move(temp[i]));
+            TempTraits::destroy(temp_alloc, temp + i);
+        }
+        TempTraits::deallocate(temp_alloc, temp, count);
+    }
+
+    // Освобождает позицию index, сдвигая хвост на один элемент одним memmove,
+    // и перемещает туда value. Место под ещё один элемент должно быть свободно
+    SIMPLE_VECTOR_CONSTEXPR void ShiftAndConstruct(size_t index, Type&& value) {
+        assert(size_ < GetCapacity());
+        simple_vector_stats::RecordShifted<Type>(size_ - index);
+        Type* slot = Data() + index;
+        RelocateBitwise(slot, DataEnd(), slot + 1);
+        try {
+            Construct(slot, std::move(value));
+        } catch (...) {
+            RelocateBitwise(slot + 1, DataEnd() + 1, slot);
+            throw;
+        }
+        ++size_;
+    }
+
+    // Ниже аналоги алгоритмов std::uninitialized_*, конструирующие элементы
+    // через аллокатор. При исключении уже созданные элементы уничтожаются
+
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR void Construct(Type* p, Args&&... args) {
+        AllocTraits::construct(items_.GetAllocator(), p, std::forward<Args>(args)...);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void Destroy(Type* first, Type* last) noexcept {
+        for (; first != last; ++first) {
+            AllocTraits::destroy(items_.GetAllocator(), first);
+        }
+    }
+
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedCopy(InputIt first, InputIt last, Type* dest) {
+        Type* current = dest;
+        try {
+            for (; first != last; ++first, ++current) {
+                Construct(current, *first);
+            }
+        } catch (...) {
+            Destroy(dest, current);
+            throw;
+        }
+        return current;
+    }
+
+    // Конструирует count элементов из first, first + 1, ... и возвращает итератор за последним прочитанным
+    template <typename InputIt>
+    SIMPLE_VECTOR_CONSTEXPR InputIt UninitializedCopyN(InputIt first, size_t count, Type* dest) {
+        Type* current = dest;
+        try {
+            for (; count > 0; --count, ++first, ++current) {
+                Construct(current, *first);
+            }
+        } catch (...) {
+            Destroy(dest, current);
+            throw;
+        }
+        return first;
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMove(Type* first, Type* last, Type* dest) {
+        return UninitializedCopy(std::make_move_iterator(first), std::make_move_iterator(last), dest);
+    }
+
+    // Перемещает элементы как std::move_if_noexcept: если перемещение может бросить исключение,
+    // а Type копируем, элементы копируются и источник остаётся нетронутым
+    SIMPLE_VECTOR_CONSTEXPR Type* UninitializedMoveIfNoexcept(Type* first, Type* last, Type* dest) {
+        if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+            return UninitializedMove(first, last, dest);
+        } else {
+            return UninitializedCopy(first, last, dest);
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void UninitializedFill(Type* first, Type* last, const Type& value) {
+        Type* current = first;
+        try {
+            for (; current != last; ++current) {
+                Construct(current, value);
+            }
+        } catch (...) {
+            Destroy(first, current);
+            throw;
+        }
+    }
+
+    // Тривиальные элементы не инициализируются вовсе, остальные создаёт Alloc::construct
+    void UninitializedDefaultConstruct(Type* first, Type* last) {
+        if constexpr (!std::is_trivially_default_constructible_v<Type>) {
+            Type* current = first;
+            try {
+                for (; current != last; ++current) {
+                    Construct(current);
+                }
+            } catch (...) {
+                Destroy(first, current);
+                throw;
+            }
+        }
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void UninitializedValueConstruct(Type* first, Type* last) {
+        Type* current = first;
+        try {
+            for (; current != last; ++current) {
+                Construct(current);
+            }
+        } catch (...) {
+            Destroy(first, current);
+            throw;
+        }
+    }
+
     ItemsPtr items_;
     size_t size_ = 0;
-    size_t capacity_ = 0;
+#if SIMPLE_VECTOR_HARDENING >= 2
+    size_t generation_ = simple_vector_detail::NextGeneration();
+#endif
 };
 
-template <typename Type>
-inline bool operator==(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return (&lhs == &rhs) || (lhs.GetSize() == rhs.GetSize() && std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator==(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    return (&lhs == &rhs) || (lhs.GetSize() == rhs.GetSize() && ElementsEqual(lhs.Data(), rhs.Data(), lhs.GetSize()));
 }
 
-template <typename Type>
-inline bool operator!=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator!=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(lhs==rhs);
 }
 
-template <typename Type>
-inline bool operator<(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
-    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    return LexicographicalLess(lhs.Data(), lhs.GetSize(), rhs.Data(), rhs.GetSize());
 }
 
-template <typename Type>
-inline bool operator<=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator<=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(rhs<lhs);
 }
 
-template <typename Type>
-inline bool operator>(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return (rhs<lhs);
 }
 
-template <typename Type>
-inline bool operator>=(const SimpleVector<Type>& lhs, const SimpleVector<Type>& rhs) {
+template <typename Type, typename Alloc, typename Growth>
+SIMPLE_VECTOR_CONSTEXPR inline bool operator>=(const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
     return !(lhs>rhs);
 }
+
+// Параллельные варианты == и < для больших векторов и представлений (см. parallel.h)
+
+template <typename Type>
+bool Equal(const ParallelExecution& policy, SimpleVectorConstView<Type> lhs, SimpleVectorConstView<Type> rhs) {
+    if (lhs.GetSize() != rhs.GetSize()) {
+        return false;
+    }
+    const Type* l = lhs.begin();
+    const Type* r = rhs.begin();
+    if (l == r) {
+        return true;
+    }
+    return ParallelFindFirst(policy, lhs.GetSize(), parallel_detail::PageGrid(l), [l, r](size_t i) {
+        return !(l[i] == r[i]);
+    }) == lhs.GetSize();
+}
+
+template <typename Type>
+bool Less(const ParallelExecution& policy, SimpleVectorConstView<Type> lhs, SimpleVectorConstView<Type> rhs) {
+    const size_t common = std::min(lhs.GetSize(), rhs.GetSize());
+    const Type* l = lhs.begin();
+    const Type* r = rhs.begin();
+    // как std::lexicographical_compare, элементы различаются, если один из них меньше другого
+    const size_t mismatch = ParallelFindFirst(policy, common, parallel_detail::PageGrid(l),
+                                              [l, r](size_t i) {
+        return l[i] < r[i] || r[i] < l[i];
+    });
+    return mismatch < common ? l[mismatch] < r[mismatch] : lhs.GetSize() < rhs.GetSize();
+}
+
+template <typename Type, typename Alloc, typename Growth>
+bool Equal(const ParallelExecution& policy,
+           const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    return Equal(policy, SimpleVectorConstView<Type>(lhs), SimpleVectorConstView<Type>(rhs));
+}
+
+template <typename Type, typename Alloc, typename Growth>
+bool Less(const ParallelExecution& policy,
+          const SimpleVector<Type, Alloc, Growth>& lhs, const SimpleVector<Type, Alloc, Growth>& rhs) {
+    return Less(policy, SimpleVectorConstView<Type>(lhs), SimpleVectorConstView<Type>(rhs));
+}
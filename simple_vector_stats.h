@@ -0,0 +1,165 @@
+#pragma once
+
+// Счётчики выделений памяти и перемещений элементов SimpleVector.
+// Включаются макросом SIMPLE_VECTOR_STATS, определённым до подключения simple_vector.h.
+// Без него функции Record* пусты и полностью исчезают при оптимизации.
+// Счётчики ведутся отдельно для каждого типа элементов и общие для всех аллокаторов
+// и стратегий роста; их можно перебрать через ForEachStats или вывести через DumpStats
+
+#include "constexpr_support.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <typeinfo>
+
+// Снимок счётчиков одного типа элементов
+struct SimpleVectorStatsSnapshot {
+    uint64_t allocations = 0;        // выделенные буферы, включая realloc и расширение на месте
+    uint64_t allocated_bytes = 0;    // суммарный размер выделенных буферов
+    uint64_t elements_relocated = 0; // элементы, перенесённые в новый буфер при росте
+    uint64_t elements_shifted = 0;   // элементы, сдвинутые внутри буфера при Insert и Erase
+    uint64_t max_idle_capacity = 0;  // наибольшее наблюдавшееся capacity - size, в элементах
+};
+
+class SimpleVectorStats {
+public:
+    // Счётчики для векторов с элементами типа Type. При первом обращении они
+    // регистрируются в глобальном списке
+    template <typename Type>
+    static SimpleVectorStats& For() noexcept {
+        static SimpleVectorStats stats(typeid(Type).name(), sizeof(Type));
+        return stats;
+    }
+
+    void RecordAllocation(size_t elements) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes_.fetch_add(elements * element_size_, std::memory_order_relaxed);
+    }
+
+    void RecordRelocated(size_t elements) noexcept {
+        elements_relocated_.fetch_add(elements, std::memory_order_relaxed);
+    }
+
+    void RecordShifted(size_t elements) noexcept {
+        elements_shifted_.fetch_add(elements, std::memory_order_relaxed);
+    }
+
+    void RecordIdleCapacity(size_t idle) noexcept {
+        uint64_t current = max_idle_capacity_.load(std::memory_order_relaxed);
+        while (idle > current
+               && !max_idle_capacity_.compare_exchange_weak(current, idle, std::memory_order_relaxed)) {
+        }
+    }
+
+    SimpleVectorStatsSnapshot Snapshot() const noexcept {
+        SimpleVectorStatsSnapshot snapshot;
+        snapshot.allocations = allocations_.load(std::memory_order_relaxed);
+        snapshot.allocated_bytes = allocated_bytes_.load(std::memory_order_relaxed);
+        snapshot.elements_relocated = elements_relocated_.load(std::memory_order_relaxed);
+        snapshot.elements_shifted = elements_shifted_.load(std::memory_order_relaxed);
+        snapshot.max_idle_capacity = max_idle_capacity_.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    void Reset() noexcept {
+        allocations_.store(0, std::memory_order_relaxed);
+        allocated_bytes_.store(0, std::memory_order_relaxed);
+        elements_relocated_.store(0, std::memory_order_relaxed);
+        elements_shifted_.store(0, std::memory_order_relaxed);
+        max_idle_capacity_.store(0, std::memory_order_relaxed);
+    }
+
+    // Имя типа элементов в виде std::type_info::name()
+    const char* GetTypeName() const noexcept {
+        return type_name_;
+    }
+
+    // Вызывает callback(const SimpleVectorStats&) для каждого зарегистрированного типа.
+    // Подходит для передачи счётчиков в систему метрик
+    template <typename Callback>
+    static void ForEach(Callback callback) {
+        for (const SimpleVectorStats* stats = Head().load(std::memory_order_acquire); stats != nullptr;
+             stats = stats->next_) {
+            callback(*stats);
+        }
+    }
+
+private:
+    SimpleVectorStats(const char* type_name, size_t element_size) noexcept
+        : type_name_(type_name)
+        , element_size_(element_size) {
+        next_ = Head().load(std::memory_order_relaxed);
+        while (!Head().compare_exchange_weak(next_, this, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    static std::atomic<const SimpleVectorStats*>& Head() noexcept {
+        static std::atomic<const SimpleVectorStats*> head{nullptr};
+        return head;
+    }
+
+    const char* type_name_;
+    size_t element_size_;
+    const SimpleVectorStats* next_ = nullptr;
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> allocated_bytes_{0};
+    std::atomic<uint64_t> elements_relocated_{0};
+    std::atomic<uint64_t> elements_shifted_{0};
+    std::atomic<uint64_t> max_idle_capacity_{0};
+};
+
+// Выводит счётчики всех типов элементов, по строке на тип
+inline void DumpStats(std::ostream& out) {
+    SimpleVectorStats::ForEach([&out](const SimpleVectorStats& stats) {
+        const SimpleVectorStatsSnapshot snapshot = stats.Snapshot();
+        out << stats.GetTypeName()
+            << ": allocations=" << snapshot.allocations
+            << " allocated_bytes=" << snapshot.allocated_bytes
+            << " relocated=" << snapshot.elements_relocated
+            << " shifted=" << snapshot.elements_shifted
+            << " max_idle_capacity=" << snapshot.max_idle_capacity << '\n';
+    });
+}
+
+// Точки учёта, которые вызывают ArrayPtr и SimpleVector. В константных вычислениях ничего не считают
+namespace simple_vector_stats {
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR inline void RecordAllocation([[maybe_unused]] size_t elements) noexcept {
+#ifdef SIMPLE_VECTOR_STATS
+    if (!simple_vector_detail::IsConstantEvaluated()) {
+        SimpleVectorStats::For<Type>().RecordAllocation(elements);
+    }
+#endif
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR inline void RecordRelocated([[maybe_unused]] size_t elements) noexcept {
+#ifdef SIMPLE_VECTOR_STATS
+    if (!simple_vector_detail::IsConstantEvaluated()) {
+        SimpleVectorStats::For<Type>().RecordRelocated(elements);
+    }
+#endif
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR inline void RecordShifted([[maybe_unused]] size_t elements) noexcept {
+#ifdef SIMPLE_VECTOR_STATS
+    if (!simple_vector_detail::IsConstantEvaluated()) {
+        SimpleVectorStats::For<Type>().RecordShifted(elements);
+    }
+#endif
+}
+
+template <typename Type>
+SIMPLE_VECTOR_CONSTEXPR inline void RecordIdleCapacity([[maybe_unused]] size_t idle) noexcept {
+#ifdef SIMPLE_VECTOR_STATS
+    if (!simple_vector_detail::IsConstantEvaluated()) {
+        SimpleVectorStats::For<Type>().RecordIdleCapacity(idle);
+    }
+#endif
+}
+
+}  // namespace simple_vector_stats
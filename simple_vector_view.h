@@ -0,0 +1,173 @@
+#pragma once
+#include "hardening.h"
+#include "simd_compare.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace simple_vector_view_detail {
+
+template <typename Container, typename = void>
+struct HasData : std::false_type {};
+
+template <typename Container>
+struct HasData<Container, std::void_t<decltype(std::declval<Container&>().Data())>> : std::true_type {};
+
+// Указатель на первый элемент контейнера: Data(), если он есть (у SimpleVector с проверяемыми
+// итераторами begin() не указатель, см. hardening.h), иначе begin()
+template <typename Container>
+auto DataOf(Container& container) noexcept {
+    if constexpr (HasData<Container>::value) {
+        return container.Data();
+    } else {
+        return container.begin();
+    }
+}
+
+}  // namespace simple_vector_view_detail
+
+// Невладеющее представление непрерывного куска массива: указатель и длина.
+// Неявно строится из SimpleVector, SmallSimpleVector, MappedSimpleVector и других контейнеров
+// с Data() или begin() и GetSize(), поэтому функции, которым нужно только читать или менять элементы,
+// могут принимать представление вместо копии вектора или пары итераторов.
+// Представление не продлевает жизнь элементов: оно становится недействительным, когда
+// вектор перевыделяет память или уничтожается
+template <typename Type>
+class SimpleVectorView {
+    template <typename Container>
+    using RequireContainer = std::enable_if_t<
+            !std::is_same_v<std::decay_t<Container>, SimpleVectorView>
+            && std::is_convertible_v<decltype(simple_vector_view_detail::DataOf(std::declval<Container&>())), Type*>
+            && std::is_convertible_v<decltype(std::declval<Container&>().GetSize()), size_t>>;
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = Type*;
+    using ValueType = std::remove_const_t<Type>;
+
+    SimpleVectorView() noexcept = default;
+
+    SimpleVectorView(Type* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+    }
+
+    // Представление всех элементов контейнера. Изменяемое представление временного
+    // контейнера не строится, так как изменения пропали бы вместе с ним
+    template <typename Container, typename = RequireContainer<Container>,
+              typename = std::enable_if_t<std::is_lvalue_reference_v<Container> || std::is_const_v<Type>>>
+    SimpleVectorView(Container&& container) noexcept
+        : data_(simple_vector_view_detail::DataOf(container))
+        , size_(container.GetSize()) {
+    }
+
+    // Изменяемое представление приводится к константному
+    template <typename Other, typename = std::enable_if_t<std::is_convertible_v<Other*, Type*>>>
+    SimpleVectorView(const SimpleVectorView<Other>& other) noexcept
+        : data_(other.begin())
+        , size_(other.GetSize()) {
+    }
+
+    // Возвращает количество элементов в представлении
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Сообщает, пустое ли представление
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) const {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return data_[index];
+    }
+
+    // Представление count элементов, начиная с offset; count обрезается по концу представления.
+    // Выбрасывает исключение std::out_of_range, если offset > size
+    SimpleVectorView Subview(size_t offset, size_t count = static_cast<size_t>(-1)) const {
+        if (offset > size_)
+            throw std::out_of_range{"offset > size"};
+        return {data_ + offset, std::min(count, size_ - offset)};
+    }
+
+    // Первые count элементов; count не должен превышать размер
+    SimpleVectorView First(size_t count) const noexcept {
+        SIMPLE_VECTOR_CHECK(count <= size_, "count exceeds view size");
+        return {data_, count};
+    }
+
+    // Последние count элементов; count не должен превышать размер
+    SimpleVectorView Last(size_t count) const noexcept {
+        SIMPLE_VECTOR_CHECK(count <= size_, "count exceeds view size");
+        return {data_ + size_ - count, count};
+    }
+
+    Iterator begin() const noexcept {
+        return data_;
+    }
+
+    Iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Сравнения поэлементные, как у SimpleVector. Второй операнд приводится к константному
+    // представлению, поэтому им может быть вектор или любое представление тех же элементов
+
+    friend bool operator==(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return lhs.GetSize() == rhs.GetSize()
+               && (lhs.begin() == rhs.begin() || ElementsEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
+    }
+
+    friend bool operator!=(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend bool operator<(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return LexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    }
+
+    friend bool operator<=(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return !LexicographicalLess(rhs.begin(), rhs.GetSize(), lhs.begin(), lhs.GetSize());
+    }
+
+    friend bool operator>(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return LexicographicalLess(rhs.begin(), rhs.GetSize(), lhs.begin(), lhs.GetSize());
+    }
+
+    friend bool operator>=(const SimpleVectorView& lhs, const SimpleVectorView<const ValueType>& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    Type* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Container>
+SimpleVectorView(Container&&) -> SimpleVectorView<std::remove_pointer_t<
+        decltype(simple_vector_view_detail::DataOf(std::declval<Container&>()))>>;
+
+template <typename Type>
+using SimpleVectorConstView = SimpleVectorView<const Type>;
@@ -0,0 +1,374 @@
+#pragma once
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Вектор с тем же интерфейсом, что у SimpleVector, хранящий до N элементов внутри объекта.
+// В кучу элементы переезжают, только когда размер превышает N; обратно во
+// встроенный буфер вектор не возвращается
+template <typename Type, size_t N>
+class SmallSimpleVector {
+    static_assert(N > 0, "use SimpleVector for zero inline capacity");
+
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    SmallSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    explicit SmallSimpleVector(size_t size) {
+        Init(size, [](Type* data, size_t n) {
+            std::uninitialized_value_construct_n(data, n);
+        });
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SmallSimpleVector(size_t size, const Type& value) {
+        Init(size, [&value](Type* data, size_t n) {
+            std::uninitialized_fill_n(data, n, value);
+        });
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SmallSimpleVector(std::initializer_list<Type> init) {
+        Init(init.size(), [&init](Type* data, size_t) {
+            std::uninitialized_copy(init.begin(), init.end(), data);
+        });
+    }
+
+    SmallSimpleVector(ReserveProxyObj reserved) {
+        Reserve(reserved.capacity);
+    }
+
+    SmallSimpleVector(const SmallSimpleVector& other) {
+        Init(other.size_, [&other](Type* data, size_t) {
+            std::uninitialized_copy(other.begin(), other.end(), data);
+        });
+    }
+
+    // Буфер в куче забирается целиком, элементы встроенного буфера перемещаются по одному
+    SmallSimpleVector(SmallSimpleVector&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (other.IsInline()) {
+            std::uninitialized_move(other.begin(), other.end(), data_);
+            size_ = other.size_;
+            other.Clear();
+        } else {
+            data_ = std::exchange(other.data_, other.InlineData());
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+
+    ~SmallSimpleVector() {
+        Clear();
+        FreeHeap();
+    }
+
+    SmallSimpleVector& operator=(const SmallSimpleVector& rhs) {
+        if (&rhs != this) {
+            SmallSimpleVector rhs_copy(rhs);
+            swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SmallSimpleVector& operator=(SmallSimpleVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (&rhs != this) {
+            Clear();
+            if (rhs.IsInline()) {
+                // наша вместимость не меньше N, так что элементы rhs помещаются без реаллокации
+                std::uninitialized_move(rhs.begin(), rhs.end(), data_);
+                size_ = rhs.size_;
+                rhs.Clear();
+            } else {
+                FreeHeap();
+                data_ = std::exchange(rhs.data_, rhs.InlineData());
+                size_ = std::exchange(rhs.size_, 0);
+                capacity_ = std::exchange(rhs.capacity_, N);
+            }
+        }
+        return *this;
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (capacity_ < new_capacity) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Возвращает количество элементов в массиве
+    size_t GetSize() const noexcept {
+        return size_;
+    }
+
+    // Возвращает вместимость массива; для встроенного буфера она равна N
+    size_t GetCapacity() const noexcept {
+        return capacity_;
+    }
+
+    // Сообщает, пустой ли массив
+    bool IsEmpty() const noexcept {
+        return size_ == 0;
+    }
+
+    // Сообщает, лежат ли элементы во встроенном буфере
+    bool IsInline() const noexcept {
+        return data_ == InlineData();
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < size_, "index out of range");
+        return data_[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Type& At(size_t index) {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return data_[index];
+    }
+
+    // Возвращает константную ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    const Type& At(size_t index) const {
+        if (index >= size_)
+            throw std::out_of_range{"index >= size"};
+        return data_[index];
+    }
+
+    // Уничтожает все элементы, не изменяя вместимость массива
+    void Clear() noexcept {
+        std::destroy_n(data_, size_);
+        size_ = 0;
+    }
+
+    // Изменяет размер массива.
+    // При увеличении размера новые элементы получают значение по умолчанию для типа Type,
+    // при уменьшении лишние элементы уничтожаются
+    void Resize(size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(begin() + new_size, end());
+            size_ = new_size;
+            return;
+        }
+        if (new_size > capacity_) {
+            Reallocate(std::max(capacity_ * 2, new_size));
+        }
+        std::uninitialized_value_construct(end(), begin() + new_size);
+        size_ = new_size;
+    }
+
+    Iterator begin() noexcept {
+        return data_;
+    }
+
+    Iterator end() noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator begin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    ConstIterator cbegin() const noexcept {
+        return data_;
+    }
+
+    ConstIterator cend() const noexcept {
+        return data_ + size_;
+    }
+
+    // Добавляет элемент в конец вектора
+    // При нехватке места увеличивает вдвое вместимость вектора
+    void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args прямо в конце вектора и возвращает ссылку на него
+    template <typename... Args>
+    Type& EmplaceBack(Args&&... args) {
+        if (size_ < capacity_) {
+            Type* item = new (end()) Type(std::forward<Args>(args)...);
+            ++size_;
+            return *item;
+        }
+        return *Emplace(cend(), std::forward<Args>(args)...);
+    }
+
+    // Вставляет значение value в позицию pos и возвращает итератор на него
+    Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Конструирует элемент из args в позиции pos и возвращает итератор на него.
+    // При переполнении вместимость увеличивается вдвое
+    template <typename... Args>
+    Iterator Emplace(ConstIterator pos, Args&&... args) {
+        SIMPLE_VECTOR_CHECK(cbegin() <= pos && pos <= cend(), "iterator out of range");
+        const size_t index = pos - cbegin();
+        if (size_ == capacity_) {
+            // args могут ссылаться на элементы вектора, поэтому значение создаётся до переезда
+            Type tmp(std::forward<Args>(args)...);
+            Reallocate(capacity_ * 2);
+            return Emplace(cbegin() + index, std::move(tmp));
+        }
+        if (index == size_) {
+            new (end()) Type(std::forward<Args>(args)...);
+        } else {
+            Type tmp(std::forward<Args>(args)...);
+            new (end()) Type(std::move(*(end() - 1)));
+            // новый последний элемент уже живой: если сдвиг бросит, его уничтожит деструктор
+            ++size_;
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+            data_[index] = std::move(tmp);
+            return begin() + index;
+        }
+        ++size_;
+        return begin() + index;
+    }
+
+    // Уничтожает последний элемент вектора. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(!IsEmpty(), "PopBack on empty vector");
+        --size_;
+        std::destroy_at(end());
+    }
+
+    // Удаляет элемент вектора в указанной позиции
+    Iterator Erase(ConstIterator pos) {
+        SIMPLE_VECTOR_CHECK(begin() <= pos && pos < end(), "erase position out of range");
+        Iterator change_pos = begin() + (pos - cbegin());
+        std::move(change_pos + 1, end(), change_pos);
+        PopBack();
+        return change_pos;
+    }
+
+    // Обменивает значение с другим вектором.
+    // Встроенные буферы обмениваются перемещением элементов, поэтому noexcept зависит от Type
+    void swap(SmallSimpleVector& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        if (!IsInline() && !other.IsInline()) {
+            std::swap(data_, other.data_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+            return;
+        }
+        SmallSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    // Выделяет место под size элементов и конструирует их вызовом construct(data, size).
+    // Если construct бросает исключение, буфер из кучи освобождается, так как деструктор не вызовется
+    template <typename Construct>
+    void Init(size_t size, Construct construct) {
+        Reserve(size);
+        try {
+            construct(data_, size);
+        } catch (...) {
+            FreeHeap();
+            throw;
+        }
+        size_ = size;
+    }
+
+    Type* InlineData() noexcept {
+        return reinterpret_cast<Type*>(inline_);
+    }
+
+    const Type* InlineData() const noexcept {
+        return reinterpret_cast<const Type*>(inline_);
+    }
+
+    // Переносит элементы в буфер из кучи вместимостью new_capacity.
+    // Как и SimpleVector, копирует элементы вместо перемещения, если оно может бросить исключение
+    void Reallocate(size_t new_capacity) {
+        assert(new_capacity > capacity_);
+        std::allocator<Type> alloc;
+        Type* new_data = alloc.allocate(new_capacity);
+        try {
+            if constexpr (std::is_nothrow_move_constructible_v<Type> || !std::is_copy_constructible_v<Type>) {
+                std::uninitialized_move(begin(), end(), new_data);
+            } else {
+                std::uninitialized_copy(begin(), end(), new_data);
+            }
+        } catch (...) {
+            alloc.deallocate(new_data, new_capacity);
+            throw;
+        }
+        std::destroy(begin(), end());
+        FreeHeap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    void FreeHeap() noexcept {
+        if (!IsInline()) {
+            std::allocator<Type>{}.deallocate(data_, capacity_);
+            data_ = InlineData();
+            capacity_ = N;
+        }
+    }
+
+    Type* data_ = InlineData();
+    size_t size_ = 0;
+    size_t capacity_ = N;
+    alignas(Type) unsigned char inline_[N * sizeof(Type)];
+};
+
+template <typename Type, size_t N>
+inline bool operator==(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return (&lhs == &rhs) || (lhs.GetSize() == rhs.GetSize() && ElementsEqual(lhs.begin(), rhs.begin(), lhs.GetSize()));
+}
+
+template <typename Type, size_t N>
+inline bool operator!=(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator<(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return LexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+}
+
+template <typename Type, size_t N>
+inline bool operator<=(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator>(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return (rhs < lhs);
+}
+
+template <typename Type, size_t N>
+inline bool operator>=(const SmallSimpleVector<Type, N>& lhs, const SmallSimpleVector<Type, N>& rhs) {
+    return !(lhs > rhs);
+}
@@ -0,0 +1,228 @@
+#pragma once
+#include "aligned_allocator.h"
+#include "simple_vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Вектор записей из полей Fields..., хранящий каждое поле в отдельном непрерывном столбце
+// («структура массивов»). Цикл, которому нужны только некоторые поля, читает только их столбцы
+// через Column<I>() и не тащит в кэш остальные поля записи.
+// Столбцы — SimpleVector с общей вместимостью: растут они одновременно, по правилу DoublingGrowth
+// для всей записи, а начало каждого столбца выровнено по kColumnAlignment байт для векторных загрузок.
+// Добавление записи даёт строгую гарантию: если конструктор поля бросает исключение,
+// уже добавленные поля этой записи удаляются из своих столбцов
+template <typename... Fields>
+class SoASimpleVector {
+    static_assert(sizeof...(Fields) > 0, "SoASimpleVector needs at least one field");
+
+public:
+    using Record = std::tuple<Fields...>;
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, Record>;
+
+    static constexpr size_t kFieldCount = sizeof...(Fields);
+    static constexpr size_t kColumnAlignment = std::max({size_t{64}, alignof(Fields)...});
+
+    template <typename Field>
+    using ColumnVector = SimpleVector<Field, AlignedAllocator<Field, kColumnAlignment>>;
+
+    SoASimpleVector() = default;
+
+    // Создаёт вектор из size записей, поля которых инициализированы значением по умолчанию
+    explicit SoASimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    // Создаёт вектор из std::initializer_list записей
+    SoASimpleVector(std::initializer_list<Record> init) {
+        Reserve(init.size());
+        for (const Record& record : init) {
+            PushBack(record);
+        }
+    }
+
+    SoASimpleVector(const SoASimpleVector&) = default;
+    SoASimpleVector(SoASimpleVector&&) noexcept = default;
+
+    // Строгая гарантия: почленное присваивание столбцов могло бы рассинхронизировать их
+    SoASimpleVector& operator=(const SoASimpleVector& rhs) {
+        if (&rhs != this) {
+            SoASimpleVector rhs_copy(rhs);
+            swap(rhs_copy);
+        }
+        return *this;
+    }
+
+    SoASimpleVector& operator=(SoASimpleVector&&) noexcept = default;
+
+    // Возвращает количество записей
+    size_t GetSize() const noexcept {
+        return std::get<0>(columns_).GetSize();
+    }
+
+    // Возвращает вместимость, общую для всех столбцов
+    size_t GetCapacity() const noexcept {
+        return std::apply([](const auto&... columns) {
+            return std::min({columns.GetCapacity()...});
+        }, columns_);
+    }
+
+    // Сообщает, пустой ли вектор
+    bool IsEmpty() const noexcept {
+        return GetSize() == 0;
+    }
+
+    // Возвращает ссылки на поля записи с индексом index
+    Reference operator[](size_t index) noexcept {
+        return std::apply([index](auto&... columns) {
+            return Reference(columns[index]...);
+        }, columns_);
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        return std::apply([index](const auto&... columns) {
+            return ConstReference(columns[index]...);
+        }, columns_);
+    }
+
+    // Возвращает ссылки на поля записи с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    Reference At(size_t index) {
+        if (index >= GetSize())
+            throw std::out_of_range{"index >= size"};
+        return (*this)[index];
+    }
+
+    ConstReference At(size_t index) const {
+        if (index >= GetSize())
+            throw std::out_of_range{"index >= size"};
+        return (*this)[index];
+    }
+
+    // Столбец поля I: непрерывный массив из GetSize() значений, выровненный по kColumnAlignment.
+    // Как и итераторы SimpleVector, становится недействительным при переносе в новый буфер
+    template <size_t I>
+    SimpleVectorView<FieldType<I>> Column() noexcept {
+        return std::get<I>(columns_);
+    }
+
+    template <size_t I>
+    SimpleVectorConstView<FieldType<I>> Column() const noexcept {
+        return std::get<I>(columns_);
+    }
+
+    // Увеличивает вместимость всех столбцов до new_capacity записей
+    void Reserve(size_t new_capacity) {
+        std::apply([new_capacity](auto&... columns) {
+            (columns.Reserve(new_capacity), ...);
+        }, columns_);
+    }
+
+    // Уничтожает все записи, не изменяя вместимость
+    void Clear() noexcept {
+        std::apply([](auto&... columns) {
+            (columns.Clear(), ...);
+        }, columns_);
+    }
+
+    // Изменяет количество записей; новые поля получают значение по умолчанию.
+    // Строгая гарантия
+    void Resize(size_t new_size) {
+        const size_t old_size = GetSize();
+        if (new_size > GetCapacity()) {
+            Reserve(DoublingGrowth::NextCapacity<Record>(GetCapacity(), new_size));
+        }
+        try {
+            std::apply([new_size](auto&... columns) {
+                (columns.Resize(new_size), ...);
+            }, columns_);
+        } catch (...) {
+            // вместимость уже достаточна, так что уменьшение не бросает
+            std::apply([old_size](auto&... columns) {
+                ((columns.GetSize() > old_size ? columns.Resize(old_size) : void()), ...);
+            }, columns_);
+            throw;
+        }
+    }
+
+    // Добавляет запись в конец вектора
+    void PushBack(const Record& record) {
+        std::apply([this](const Fields&... fields) {
+            EmplaceBack(fields...);
+        }, record);
+    }
+
+    void PushBack(Record&& record) {
+        std::apply([this](Fields&... fields) {
+            EmplaceBack(std::move(fields)...);
+        }, record);
+    }
+
+    // Конструирует поля новой записи из args, по одному аргументу на поле,
+    // и возвращает ссылки на них
+    template <typename... Args>
+    Reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == kFieldCount, "EmplaceBack takes one argument per field");
+        const size_t size = GetSize();
+        if (size == GetCapacity()) {
+            // args могут ссылаться на записи вектора, поэтому запись создаётся до переезда
+            Record tmp(std::forward<Args>(args)...);
+            Reserve(DoublingGrowth::NextCapacity<Record>(GetCapacity(), size + 1));
+            std::apply([this](Fields&... fields) {
+                EmplaceColumns(std::index_sequence_for<Fields...>{}, std::move(fields)...);
+            }, tmp);
+        } else {
+            EmplaceColumns(std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+        }
+        return (*this)[size];
+    }
+
+    // Удаляет последнюю запись. Вектор не должен быть пустым
+    void PopBack() noexcept {
+        std::apply([](auto&... columns) {
+            (columns.PopBack(), ...);
+        }, columns_);
+    }
+
+    // Обменивает значение с другим вектором
+    void swap(SoASimpleVector& other) noexcept {
+        std::apply([&other](auto&... columns) {
+            std::apply([&columns...](auto&... other_columns) {
+                (columns.swap(other_columns), ...);
+            }, other.columns_);
+        }, columns_);
+    }
+
+    friend bool operator==(const SoASimpleVector& lhs, const SoASimpleVector& rhs) {
+        return lhs.columns_ == rhs.columns_;
+    }
+
+    friend bool operator!=(const SoASimpleVector& lhs, const SoASimpleVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    // Добавляет по полю в каждый столбец; вместимости должно хватать.
+    // Если конструктор поля бросает исключение, уже добавленные поля удаляются
+    template <size_t... I, typename... Args>
+    void EmplaceColumns(std::index_sequence<I...>, Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((std::get<I>(columns_).EmplaceBack(std::forward<Args>(args)), ++constructed), ...);
+        } catch (...) {
+            ((I < constructed ? std::get<I>(columns_).PopBack() : void()), ...);
+            throw;
+        }
+    }
+
+    std::tuple<ColumnVector<Fields>...> columns_;
+};
@@ -0,0 +1,394 @@
+#pragma once
+#include "constexpr_support.h"
+#include "hardening.h"
+#include "simd_compare.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace static_vector_detail {
+
+// Элемент из args: конструктором, а для агрегатов — фигурными скобками
+template <typename Type, typename... Args>
+constexpr Type Make(Args&&... args) {
+    if constexpr (std::is_constructible_v<Type, Args...>) {
+        return Type(std::forward<Args>(args)...);
+    } else {
+        return Type{std::forward<Args>(args)...};
+    }
+}
+
+// Тривиальные типы лежат в обычном массиве, заполненном значением по умолчанию:
+// так вектор остаётся литеральным типом и тривиально копируется, а «конструирование»
+// элемента — это присваивание
+template <typename Type, size_t N, bool = std::is_trivial_v<Type>>
+class Storage {
+public:
+    constexpr Type* Data() noexcept {
+        return items_;
+    }
+
+    constexpr const Type* Data() const noexcept {
+        return items_;
+    }
+
+    template <typename... Args>
+    constexpr void Construct(Type* p, Args&&... args) {
+        *p = Make<Type>(std::forward<Args>(args)...);
+    }
+
+    constexpr void Destroy(Type* /*first*/, Type* /*last*/) noexcept {
+    }
+
+    size_t size = 0;
+
+private:
+    Type items_[N > 0 ? N : 1] = {};
+};
+
+// Остальные типы конструируются placement new в сыром буфере; только во время выполнения
+template <typename Type, size_t N>
+class Storage<Type, N, false> {
+public:
+    Storage() noexcept {
+    }
+
+    Storage(const Storage& other) {
+        ConstructFrom(other.Data(), other.size);
+    }
+
+    Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<Type>) {
+        ConstructFrom(std::make_move_iterator(other.Data()), other.size);
+    }
+
+    ~Storage() {
+        Destroy(Data(), Data() + size);
+    }
+
+    // Базовая гарантия: общие элементы присваиваются, лишние уничтожаются или досоздаются
+    Storage& operator=(const Storage& rhs) {
+        if (&rhs != this) {
+            Assign(rhs.Data(), rhs.size);
+        }
+        return *this;
+    }
+
+    Storage& operator=(Storage&& rhs) noexcept(std::is_nothrow_move_constructible_v<Type>
+                                               && std::is_nothrow_move_assignable_v<Type>) {
+        if (&rhs != this) {
+            Assign(std::make_move_iterator(rhs.Data()), rhs.size);
+        }
+        return *this;
+    }
+
+    Type* Data() noexcept {
+        return std::launder(reinterpret_cast<Type*>(bytes_));
+    }
+
+    const Type* Data() const noexcept {
+        return std::launder(reinterpret_cast<const Type*>(bytes_));
+    }
+
+    template <typename... Args>
+    void Construct(Type* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) Type(std::forward<Args>(args)...);
+    }
+
+    void Destroy(Type* first, Type* last) noexcept {
+        std::destroy(first, last);
+    }
+
+    size_t size = 0;
+
+private:
+    // Конструирует count элементов из first в пустом хранилище; при исключении уничтожает созданные
+    template <typename InputIt>
+    void ConstructFrom(InputIt first, size_t count) {
+        try {
+            for (; size < count; ++size, ++first) {
+                Construct(Data() + size, *first);
+            }
+        } catch (...) {
+            Destroy(Data(), Data() + size);
+            size = 0;
+            throw;
+        }
+    }
+
+    template <typename InputIt>
+    void Assign(InputIt first, size_t count) {
+        const size_t common = std::min(size, count);
+        std::copy_n(first, common, Data());
+        if (count < size) {
+            Destroy(Data() + count, Data() + size);
+            size = count;
+        } else {
+            for (std::advance(first, common); size < count; ++size, ++first) {
+                Construct(Data() + size, *first);
+            }
+        }
+    }
+
+    alignas(Type) unsigned char bytes_[(N > 0 ? N : 1) * sizeof(Type)];
+};
+
+}  // namespace static_vector_detail
+
+// Вектор с вместимостью N, хранящий элементы внутри объекта, без обращений к куче.
+// API тот же, что у SimpleVector, но вместимость постоянна: операция, которой не хватает места,
+// выбрасывает std::length_error и оставляет вектор прежним.
+// Для тривиальных Type (целые числа, POD-структуры) в C++20 вектор можно целиком построить
+// при компиляции и объявить constexpr: компилятор кладёт его в .rodata, и таблице не нужна
+// инициализация при запуске. Такой вектор тривиально копируется, но всегда хранит N элементов,
+// заполненных значением по умолчанию за концом.
+// Остальные типы лежат в неинициализированном буфере и работают только во время выполнения
+template <typename Type, size_t N>
+class StaticSimpleVector {
+public:
+    using Iterator = Type*;
+    using ConstIterator = const Type*;
+
+    static constexpr size_t kCapacity = N;
+
+    constexpr StaticSimpleVector() noexcept = default;
+
+    // Создаёт вектор из size элементов, инициализированных значением по умолчанию
+    SIMPLE_VECTOR_CONSTEXPR explicit StaticSimpleVector(size_t size) {
+        Resize(size);
+    }
+
+    // Создаёт вектор из size элементов, инициализированных значением value
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(size_t size, const Type& value) {
+        RequireCapacity(size);
+        for (; storage_.size < size; ++storage_.size) {
+            storage_.Construct(end(), value);
+        }
+    }
+
+    // Создаёт вектор из std::initializer_list
+    SIMPLE_VECTOR_CONSTEXPR StaticSimpleVector(std::initializer_list<Type> init) {
+        RequireCapacity(init.size());
+        for (const Type& item : init) {
+            storage_.Construct(end(), item);
+            ++storage_.size;
+        }
+    }
+
+    // Возвращает количество элементов в векторе
+    constexpr size_t GetSize() const noexcept {
+        return storage_.size;
+    }
+
+    // Возвращает вместимость, всегда равную N
+    constexpr size_t GetCapacity() const noexcept {
+        return N;
+    }
+
+    // Сообщает, пустой ли вектор
+    constexpr bool IsEmpty() const noexcept {
+        return storage_.size == 0;
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    constexpr Type& operator[](size_t index) noexcept {
+        SIMPLE_VECTOR_CHECK(index < storage_.size, "index out of range");
+        return storage_.Data()[index];
+    }
+
+    constexpr const Type& operator[](size_t index) const noexcept {
+        SIMPLE_VECTOR_CHECK(index < storage_.size, "index out of range");
+        return storage_.Data()[index];
+    }
+
+    // Возвращает ссылку на элемент с индексом index
+    // Выбрасывает исключение std::out_of_range, если index >= size
+    constexpr Type& At(size_t index) {
+        if (index >= storage_.size)
+            throw std::out_of_range{"index >= size"};
+        return storage_.Data()[index];
+    }
+
+    constexpr const Type& At(size_t index) const {
+        if (index >= storage_.size)
+            throw std::out_of_range{"index >= size"};
+        return storage_.Data()[index];
+    }
+
+    // Ничего не делает, если new_capacity <= N, иначе выбрасывает std::length_error
+    constexpr void Reserve(size_t new_capacity) const {
+        RequireCapacity(new_capacity);
+    }
+
+    // Уничтожает все элементы
+    SIMPLE_VECTOR_CONSTEXPR void Clear() noexcept {
+        storage_.Destroy(begin(), end());
+        storage_.size = 0;
+    }
+
+    // Изменяет размер; новые элементы получают значение по умолчанию.
+    // Строгая гарантия
+    SIMPLE_VECTOR_CONSTEXPR void Resize(size_t new_size) {
+        if (new_size <= storage_.size) {
+            storage_.Destroy(begin() + new_size, end());
+            storage_.size = new_size;
+            return;
+        }
+        RequireCapacity(new_size);
+        const size_t old_size = storage_.size;
+        try {
+            for (; storage_.size < new_size; ++storage_.size) {
+                storage_.Construct(end());
+            }
+        } catch (...) {
+            storage_.Destroy(begin() + old_size, end());
+            storage_.size = old_size;
+            throw;
+        }
+    }
+
+    constexpr Iterator begin() noexcept {
+        return storage_.Data();
+    }
+
+    constexpr Iterator end() noexcept {
+        return storage_.Data() + storage_.size;
+    }
+
+    constexpr ConstIterator begin() const noexcept {
+        return storage_.Data();
+    }
+
+    constexpr ConstIterator end() const noexcept {
+        return storage_.Data() + storage_.size;
+    }
+
+    constexpr ConstIterator cbegin() const noexcept {
+        return begin();
+    }
+
+    constexpr ConstIterator cend() const noexcept {
+        return end();
+    }
+
+    // Добавляет элемент в конец вектора. Строгая гарантия
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(const Type& item) {
+        EmplaceBack(item);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR void PushBack(Type&& item) {
+        EmplaceBack(std::move(item));
+    }
+
+    // Конструирует элемент из args в конце вектора и возвращает ссылку на него.
+    // Строгая гарантия
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Type& EmplaceBack(Args&&... args) {
+        RequireCapacity(storage_.size + 1);
+        Type* item = end();
+        storage_.Construct(item, std::forward<Args>(args)...);
+        ++storage_.size;
+        return *item;
+    }
+
+    // Вставляет значение value в позицию pos и возвращает итератор на него
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, const Type& value) {
+        return Emplace(pos, value);
+    }
+
+    SIMPLE_VECTOR_CONSTEXPR Iterator Insert(ConstIterator pos, Type&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Конструирует элемент из args в позиции pos и возвращает итератор на него.
+    // Не в конце элемент сначала создаётся во временном объекте, так как args могут ссылаться
+    // на элементы самого вектора. Строгая гарантия при вставке в конец и для Type
+    // с небросающим перемещением, иначе базовая
+    template <typename... Args>
+    SIMPLE_VECTOR_CONSTEXPR Iterator Emplace(ConstIterator pos, Args&&... args) {
+        SIMPLE_VECTOR_CHECK(cbegin() <= pos && pos <= cend(), "iterator out of range");
+        const size_t index = pos - cbegin();
+        RequireCapacity(storage_.size + 1);
+        if (index == storage_.size) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        Type tmp = static_vector_detail::Make<Type>(std::forward<Args>(args)...);
+        Type* items = begin();
+        storage_.Construct(end(), std::move(items[storage_.size - 1]));
+        ++storage_.size;
+        std::move_backward(items + index, end() - 2, end() - 1);
+        items[index] = std::move(tmp);
+        return items + index;
+    }
+
+    // Уничтожает последний элемент вектора. Вектор не должен быть пустым
+    SIMPLE_VECTOR_CONSTEXPR void PopBack() noexcept {
+        SIMPLE_VECTOR_CHECK(!IsEmpty(), "PopBack on empty vector");
+        --storage_.size;
+        storage_.Destroy(end(), end() + 1);
+    }
+
+    // Удаляет элемент в позиции pos и возвращает итератор на следующий за ним
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator pos) {
+        SIMPLE_VECTOR_CHECK(cbegin() <= pos && pos < cend(), "erase position out of range");
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз
+    SIMPLE_VECTOR_CONSTEXPR Iterator Erase(ConstIterator first, ConstIterator last) {
+        SIMPLE_VECTOR_CHECK(cbegin() <= first && first <= last && last <= cend(), "erase range out of range");
+        Iterator erase_first = begin() + (first - cbegin());
+        Iterator erase_last = begin() + (last - cbegin());
+        Iterator new_end = std::move(erase_last, end(), erase_first);
+        storage_.Destroy(new_end, end());
+        storage_.size = new_end - begin();
+        return erase_first;
+    }
+
+    // Обменивает значение с другим вектором поэлементным перемещением
+    SIMPLE_VECTOR_CONSTEXPR void swap(StaticSimpleVector& other) noexcept(
+            std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>) {
+        StaticSimpleVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator==(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return lhs.GetSize() == rhs.GetSize() && ElementsEqual(lhs.begin(), rhs.begin(), lhs.GetSize());
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator!=(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return LexicographicalLess(lhs.begin(), lhs.GetSize(), rhs.begin(), rhs.GetSize());
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator<=(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return !(rhs < lhs);
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return rhs < lhs;
+    }
+
+    friend SIMPLE_VECTOR_CONSTEXPR bool operator>=(const StaticSimpleVector& lhs, const StaticSimpleVector& rhs) {
+        return !(lhs < rhs);
+    }
+
+private:
+    static constexpr void RequireCapacity(size_t capacity) {
+        if (capacity > N) {
+            throw std::length_error{"StaticSimpleVector capacity exceeded"};
+        }
+    }
+
+    static_vector_detail::Storage<Type, N> storage_;
+};